@@ -0,0 +1,87 @@
+#include <benchmark/benchmark.h>
+
+#include <components/lua/serialization.hpp>
+
+namespace
+{
+    // Payload similar to what mods send in events: an array of records with a few fields each.
+    sol::table makePayload(sol::state& lua, std::size_t size)
+    {
+        sol::table payload(lua, sol::create);
+        for (std::size_t i = 1; i <= size; ++i)
+        {
+            sol::table record(lua, sol::create);
+            record["id"] = "some_object_id_" + std::to_string(i);
+            record["count"] = i;
+            record["health"] = 0.5 * i;
+            record["hostile"] = i % 2 == 0;
+            payload[i] = record;
+        }
+        return payload;
+    }
+
+    void serializeEventPayload(benchmark::State& state)
+    {
+        sol::state lua;
+        const sol::table payload = makePayload(lua, state.range(0));
+        for (auto _ : state)
+        {
+            LuaUtil::BinaryData data = LuaUtil::serialize(payload);
+            benchmark::DoNotOptimize(data);
+        }
+    }
+
+    void serializeEventPayloadToPool(benchmark::State& state)
+    {
+        sol::state lua;
+        const sol::table payload = makePayload(lua, state.range(0));
+        LuaUtil::BinaryDataPool pool;
+        for (auto _ : state)
+        {
+            LuaUtil::BinaryData data = pool.acquire();
+            LuaUtil::serialize(data, payload);
+            benchmark::DoNotOptimize(data);
+            pool.release(std::move(data));
+        }
+    }
+
+    void deserializeEventPayload(benchmark::State& state)
+    {
+        sol::state lua;
+        const LuaUtil::BinaryData data = LuaUtil::serialize(makePayload(lua, state.range(0)));
+        for (auto _ : state)
+        {
+            sol::object result = LuaUtil::deserialize(lua, data);
+            benchmark::DoNotOptimize(result);
+        }
+        state.SetBytesProcessed(state.iterations() * data.size());
+    }
+
+    // One event delivered to many receivers: serialized once, deserialized for every receiver.
+    void broadcastEventPayload(benchmark::State& state)
+    {
+        constexpr int receivers = 50;
+        sol::state lua;
+        const sol::table payload = makePayload(lua, state.range(0));
+        LuaUtil::BinaryDataPool pool;
+        for (auto _ : state)
+        {
+            LuaUtil::BinaryData data = pool.acquire();
+            LuaUtil::serialize(data, payload);
+            for (int i = 0; i < receivers; ++i)
+            {
+                sol::object result = LuaUtil::deserialize(lua, data);
+                benchmark::DoNotOptimize(result);
+            }
+            pool.release(std::move(data));
+            lua.collect_garbage();
+        }
+    }
+}
+
+BENCHMARK(serializeEventPayload)->Arg(10)->Arg(100)->Arg(1000);
+BENCHMARK(serializeEventPayloadToPool)->Arg(10)->Arg(100)->Arg(1000);
+BENCHMARK(deserializeEventPayload)->Arg(10)->Arg(100)->Arg(1000);
+BENCHMARK(broadcastEventPayload)->Arg(10)->Arg(100)->Arg(1000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,61 @@
+#include <benchmark/benchmark.h>
+
+#include <components/misc/spatialgrid.hpp>
+
+#include <random>
+
+namespace
+{
+    // Crowd of actors like in a big battle or a town: every actor looks for its neighbours every frame.
+    constexpr float worldSize = 8192;
+
+    std::vector<osg::Vec3f> generatePositions(std::size_t count)
+    {
+        std::minstd_rand random;
+        std::uniform_real_distribution<float> distribution(0, worldSize);
+        std::vector<osg::Vec3f> result;
+        result.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+            result.emplace_back(distribution(random), distribution(random), distribution(random) / 16);
+        return result;
+    }
+
+    void findNeighboursWithLinearSearch(benchmark::State& state)
+    {
+        const std::vector<osg::Vec3f> positions = generatePositions(state.range(0));
+        const float radius = static_cast<float>(state.range(1));
+        for (auto _ : state)
+        {
+            std::size_t found = 0;
+            for (const osg::Vec3f& position : positions)
+                for (const osg::Vec3f& other : positions)
+                    if ((other - position).length2() <= radius * radius)
+                        ++found;
+            benchmark::DoNotOptimize(found);
+        }
+    }
+
+    void findNeighboursWithGrid(benchmark::State& state)
+    {
+        const std::vector<osg::Vec3f> positions = generatePositions(state.range(0));
+        const float radius = static_cast<float>(state.range(1));
+        Misc::SpatialGrid<std::size_t> grid(512);
+        for (auto _ : state)
+        {
+            // Rebuilt every frame as actors move
+            grid.clear();
+            for (std::size_t i = 0; i < positions.size(); ++i)
+                grid.insert(positions[i], i);
+            grid.build();
+            std::size_t found = 0;
+            for (const osg::Vec3f& position : positions)
+                grid.forEachInRadius(position, radius, [&](std::size_t, const osg::Vec3f&) { ++found; });
+            benchmark::DoNotOptimize(found);
+        }
+    }
+}
+
+BENCHMARK(findNeighboursWithLinearSearch)->ArgsProduct({ { 100, 300, 1000 }, { 400, 2048 } });
+BENCHMARK(findNeighboursWithGrid)->ArgsProduct({ { 100, 300, 1000 }, { 400, 2048 } });
+
+BENCHMARK_MAIN();
@@ -755,7 +755,7 @@ void OMW::Engine::prepareEngine()
     mEnvironment.setInputManager(*mInputManager);
 
     // Create sound system
-    mSoundManager = std::make_unique<MWSound::SoundManager>(mVFS.get(), mUseSound);
+    mSoundManager = std::make_unique<MWSound::SoundManager>(mVFS.get(), mUseSound, mCfgMgr.getCachePath());
     mEnvironment.setSoundManager(*mSoundManager);
 
     if (!mSkipMenu)
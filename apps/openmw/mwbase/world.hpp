@@ -81,6 +81,7 @@ namespace DetourNavigator
 {
     struct Navigator;
     struct AgentBounds;
+    class AsyncPathFinder;
 }
 
 namespace MWWorld
@@ -658,6 +659,9 @@ namespace MWBase
 
         virtual DetourNavigator::Navigator* getNavigator() const = 0;
 
+        /// Returns nullptr if paths have to be found in the main thread.
+        virtual DetourNavigator::AsyncPathFinder* getAsyncPathFinder() const = 0;
+
         virtual void updateActorPath(const MWWorld::ConstPtr& actor, const std::deque<osg::Vec3f>& path,
             const DetourNavigator::AgentBounds& agentBounds, const osg::Vec3f& start, const osg::Vec3f& end) const = 0;
 
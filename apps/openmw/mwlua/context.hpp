@@ -5,6 +5,7 @@
 
 namespace LuaUtil
 {
+    class BinaryDataPool;
     class LuaState;
     class UserdataSerializer;
 }
@@ -23,6 +24,7 @@ namespace MWLua
         WorldView* mWorldView;
         LocalEventQueue* mLocalEventQueue;
         GlobalEventQueue* mGlobalEventQueue;
+        LuaUtil::BinaryDataPool* mEventDataPool;
     };
 
 }
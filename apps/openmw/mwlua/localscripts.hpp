@@ -24,6 +24,9 @@ namespace MWLua
 
         MWBase::LuaManager::ActorControls* getActorControls() { return &mData.mControls; }
 
+        // Returns an empty Ptr if the object is not available.
+        MWWorld::Ptr getPtr() const { return mData.isValid() ? mData.ptr() : MWWorld::Ptr(); }
+
         struct SelfObject : public LObject
         {
             class CachedStat
@@ -48,14 +48,15 @@ namespace MWLua
     {
         auto* lua = context.mLua;
         sol::table api(lua->sol(), sol::create);
-        api["API_REVISION"] = 30;
+        api["API_REVISION"] = 32;
         api["quit"] = [lua]() {
             Log(Debug::Warning) << "Quit requested by a Lua script.\n" << lua->debugTraceback();
             MWBase::Environment::get().getStateManager()->requestQuit();
         };
         api["sendGlobalEvent"] = [context](std::string eventName, const sol::object& eventData) {
-            context.mGlobalEventQueue->push_back(
-                { std::move(eventName), LuaUtil::serialize(eventData, context.mSerializer) });
+            LuaUtil::BinaryData data = context.mEventDataPool->acquire();
+            LuaUtil::serialize(data, eventData, context.mSerializer);
+            context.mGlobalEventQueue->push_back({ std::move(eventName), std::move(data) });
         };
         addTimeBindings(api, context, false);
         api["l10n"] = LuaUtil::initL10nLoader(lua->sol(), MWBase::Environment::get().getL10nManager());
@@ -1,5 +1,7 @@
 #include "luamanagerimp.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <filesystem>
 
 #include <osg/Stats>
@@ -51,6 +53,14 @@ namespace MWLua
         mLocalLoader = createUserdataSerializer(true, mWorldView.getObjectRegistry(), &mContentFileMapping);
 
         mGlobalScripts.setSerializer(mGlobalSerializer.get());
+
+        LuaUtil::UpdateScheduler::Settings schedulerSettings;
+        schedulerSettings.mBudget = std::chrono::duration_cast<LuaUtil::UpdateScheduler::Duration>(
+            std::chrono::duration<float, std::milli>(Settings::Manager::getFloat("lua update budget", "Lua")));
+        schedulerSettings.mFullRatePriority = Settings::Manager::getFloat("lua update full rate distance", "Lua");
+        schedulerSettings.mMaxSkippedFrames
+            = static_cast<unsigned>(std::max(0, Settings::Manager::getInt("lua update max skipped frames", "Lua")));
+        mLocalUpdateScheduler.setSettings(schedulerSettings);
     }
 
     void LuaManager::initConfiguration()
@@ -71,6 +81,7 @@ namespace MWLua
         context.mWorldView = &mWorldView;
         context.mLocalEventQueue = &mLocalEvents;
         context.mGlobalEventQueue = &mGlobalEvents;
+        context.mEventDataPool = &mEventDataPool;
         context.mSerializer = mGlobalSerializer.get();
 
         Context localContext = context;
@@ -83,6 +94,8 @@ namespace MWLua
         initCellBindingsForLocalScripts(localContext);
         LocalScripts::initializeSelfPackage(localContext);
         LuaUtil::LuaStorage::initLuaBindings(mLua.sol());
+        mGlobalStorage.setDeferCallbacks(true);
+        mPlayerStorage.setDeferCallbacks(true);
 
         mLua.addCommonPackage("openmw.async", getAsyncPackageInitializer(context));
         mLua.addCommonPackage("openmw.util", LuaUtil::initUtilPackage(mLua.sol()));
@@ -159,22 +172,47 @@ namespace MWLua
         // Receive events
         for (GlobalEvent& e : globalEvents)
             mGlobalScripts.receiveEvent(e.mEventName, e.mEventData);
-        for (LocalEvent& e : localEvents)
+        // Consecutive events with the same name and data (usually sent in a loop to many objects) are delivered
+        // as a batch, so the data is deserialized only once.
+        std::vector<LuaUtil::ScriptsContainer*> receivers;
+        for (std::size_t begin = 0; begin < localEvents.size();)
         {
-            LObject obj(e.mDest, objectRegistry);
-            LocalScripts* scripts = obj.isValid() ? obj.ptr().getRefData().getLuaScripts() : nullptr;
-            if (scripts)
-                scripts->receiveEvent(e.mEventName, e.mEventData);
-            else
-                Log(Debug::Debug) << "Ignored event " << e.mEventName << " to L" << idToString(e.mDest)
-                                  << ". Object not found or has no attached scripts";
+            const LocalEvent& first = localEvents[begin];
+            std::size_t end = begin + 1;
+            while (end < localEvents.size() && localEvents[end].mEventName == first.mEventName
+                && localEvents[end].mEventData == first.mEventData)
+                ++end;
+            receivers.clear();
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                const LocalEvent& e = localEvents[i];
+                LObject obj(e.mDest, objectRegistry);
+                LocalScripts* scripts = obj.isValid() ? obj.ptr().getRefData().getLuaScripts() : nullptr;
+                if (scripts)
+                    receivers.push_back(scripts);
+                else
+                    Log(Debug::Debug) << "Ignored event " << e.mEventName << " to L" << idToString(e.mDest)
+                                      << ". Object not found or has no attached scripts";
+            }
+            LuaUtil::ScriptsContainer::receiveEvent(first.mEventName, first.mEventData, receivers);
+            begin = end;
         }
 
+        // Event payloads are not needed anymore; keep their memory for the next events.
+        for (GlobalEvent& e : globalEvents)
+            mEventDataPool.release(std::move(e.mEventData));
+        for (LocalEvent& e : localEvents)
+            mEventDataPool.release(std::move(e.mEventData));
+
         // Run queued callbacks
         for (CallbackWithData& c : mQueuedCallbacks)
             c.mCallback.tryCall(c.mArg);
         mQueuedCallbacks.clear();
 
+        // Storage subscriptions; all changes made since the previous frame are delivered at once.
+        mGlobalStorage.flushCallbacks();
+        mPlayerStorage.flushCallbacks();
+
         // Engine handlers in local scripts
         for (const LocalEngineEvent& e : mLocalEngineEvents)
         {
@@ -194,8 +232,13 @@ namespace MWLua
 
         if (!mWorldView.isPaused())
         {
-            for (LocalScripts* scripts : mActiveLocalScripts)
-                scripts->update(frameDuration);
+            const osg::Vec3f playerPos = mPlayer.getRefData().getPosition().asVec3();
+            mLocalUpdateScheduler.update(frameDuration, [&](const LuaUtil::ScriptsContainer& container) {
+                const MWWorld::Ptr ptr = static_cast<const LocalScripts&>(container).getPtr();
+                if (ptr.isEmpty() || ptr == mPlayer)
+                    return 0.f;
+                return (ptr.getRefData().getPosition().asVec3() - playerPos).length();
+            });
         }
 
         // Engine handlers in global scripts
@@ -274,6 +317,7 @@ namespace MWLua
         MWBase::Environment::get().getWindowManager()->setConsoleMode("");
         MWBase::Environment::get().getWorld()->getPostProcessor()->disableDynamicShaders();
         mActiveLocalScripts.clear();
+        mLocalUpdateScheduler.clear();
         mLocalEvents.clear();
         mGlobalEvents.clear();
         mInputEvents.clear();
@@ -308,7 +352,7 @@ namespace MWLua
             localScripts = createLocalScripts(ptr);
             localScripts->addAutoStartedScripts();
         }
-        mActiveLocalScripts.insert(localScripts);
+        activateLocalScripts(localScripts);
         mLocalEngineEvents.push_back({ getId(ptr), LocalScripts::OnActive{} });
         mPlayerChanged = true;
     }
@@ -345,7 +389,7 @@ namespace MWLua
         }
         if (localScripts)
         {
-            mActiveLocalScripts.insert(localScripts);
+            activateLocalScripts(localScripts);
             mLocalEngineEvents.push_back({ getId(ptr), LocalScripts::OnActive{} });
         }
 
@@ -359,7 +403,7 @@ namespace MWLua
         LocalScripts* localScripts = ptr.getRefData().getLuaScripts();
         if (localScripts)
         {
-            mActiveLocalScripts.erase(localScripts);
+            deactivateLocalScripts(localScripts);
             if (!mWorldView.getObjectRegistry()->getPtr(getId(ptr), true).isEmpty())
                 mLocalEngineEvents.push_back({ getId(ptr), LocalScripts::OnInactive{} });
         }
@@ -404,11 +448,23 @@ namespace MWLua
             localScripts = createLocalScripts(ptr);
             localScripts->addAutoStartedScripts();
             if (ptr.isInCell() && MWBase::Environment::get().getWorldScene()->isCellActive(*ptr.getCell()))
-                mActiveLocalScripts.insert(localScripts);
+                activateLocalScripts(localScripts);
         }
         localScripts->addCustomScript(scriptId);
     }
 
+    void LuaManager::activateLocalScripts(LocalScripts* scripts)
+    {
+        if (mActiveLocalScripts.insert(scripts).second)
+            mLocalUpdateScheduler.add(scripts);
+    }
+
+    void LuaManager::deactivateLocalScripts(LocalScripts* scripts)
+    {
+        mActiveLocalScripts.erase(scripts);
+        mLocalUpdateScheduler.remove(scripts);
+    }
+
     LocalScripts* LuaManager::createLocalScripts(
         const MWWorld::Ptr& ptr, std::optional<LuaUtil::ScriptIdsWithInitializationData> autoStartConf)
     {
@@ -606,5 +662,8 @@ namespace MWLua
     {
         const sol::state_view state(mLua.sol());
         stats.setAttribute(frameNumber, "Lua UsedMemory", state.memory_used());
+        const LuaUtil::UpdateScheduler::Stats& schedulerStats = mLocalUpdateScheduler.getStats();
+        stats.setAttribute(frameNumber, "Lua Updated", schedulerStats.mUpdated);
+        stats.setAttribute(frameNumber, "Lua Deferred", schedulerStats.mDeferred);
     }
 }
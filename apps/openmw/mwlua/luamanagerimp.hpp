@@ -6,6 +6,7 @@
 
 #include <components/lua/luastate.hpp>
 #include <components/lua/storage.hpp>
+#include <components/lua/updatescheduler.hpp>
 
 #include <components/lua_ui/resources.hpp>
 
@@ -126,6 +127,8 @@ namespace MWLua
 
     private:
         void initConfiguration();
+        void activateLocalScripts(LocalScripts* scripts);
+        void deactivateLocalScripts(LocalScripts* scripts);
         LocalScripts* createLocalScripts(const MWWorld::Ptr& ptr,
             std::optional<LuaUtil::ScriptIdsWithInitializationData> autoStartConf = std::nullopt);
 
@@ -146,6 +149,7 @@ namespace MWLua
 
         GlobalScripts mGlobalScripts{ &mLua };
         std::set<LocalScripts*> mActiveLocalScripts;
+        LuaUtil::UpdateScheduler mLocalUpdateScheduler;
         WorldView mWorldView;
 
         bool mPlayerChanged = false;
@@ -154,6 +158,7 @@ namespace MWLua
 
         GlobalEventQueue mGlobalEvents;
         LocalEventQueue mLocalEvents;
+        LuaUtil::BinaryDataPool mEventDataPool;
 
         std::unique_ptr<LuaUtil::UserdataSerializer> mGlobalSerializer;
         std::unique_ptr<LuaUtil::UserdataSerializer> mLocalSerializer;
@@ -1,5 +1,7 @@
 #include "luabindings.hpp"
 
+#include <limits>
+
 #include <components/detournavigator/navigator.hpp>
 #include <components/detournavigator/navigatorutils.hpp>
 #include <components/lua/luastate.hpp>
@@ -22,6 +24,28 @@ namespace sol
 
 namespace MWLua
 {
+    namespace
+    {
+        MWPhysics::RayCastingRequest makeRayCastingRequest(
+            const osg::Vec3f& from, const osg::Vec3f& to, const sol::optional<sol::table>& options)
+        {
+            MWPhysics::RayCastingRequest request;
+            request.mFrom = from;
+            request.mTo = to;
+            if (options)
+            {
+                sol::optional<LObject> ignoreObj = options->get<sol::optional<LObject>>("ignore");
+                if (ignoreObj)
+                    request.mIgnore = ignoreObj->ptr();
+                request.mMask = options->get<sol::optional<int>>("collisionType").value_or(request.mMask);
+                request.mRadius = options->get<sol::optional<float>>("radius").value_or(0);
+            }
+            if (request.mRadius > 0 && !request.mIgnore.isEmpty())
+                throw std::logic_error("Currently castRay doesn't support `ignore` when radius > 0");
+            return request;
+        }
+    }
+
     sol::table initNearbyPackage(const Context& context)
     {
         sol::table api(context.mLua->sol(), sol::create);
@@ -67,26 +91,28 @@ namespace MWLua
             }));
 
         api["castRay"] = [](const osg::Vec3f& from, const osg::Vec3f& to, sol::optional<sol::table> options) {
-            MWWorld::Ptr ignore;
-            int collisionType = MWPhysics::CollisionType_Default;
-            float radius = 0;
-            if (options)
-            {
-                sol::optional<LObject> ignoreObj = options->get<sol::optional<LObject>>("ignore");
-                if (ignoreObj)
-                    ignore = ignoreObj->ptr();
-                collisionType = options->get<sol::optional<int>>("collisionType").value_or(collisionType);
-                radius = options->get<sol::optional<float>>("radius").value_or(0);
-            }
+            const MWPhysics::RayCastingRequest request = makeRayCastingRequest(from, to, options);
             const MWPhysics::RayCastingInterface* rayCasting = MWBase::Environment::get().getWorld()->getRayCasting();
-            if (radius <= 0)
-                return rayCasting->castRay(from, to, ignore, std::vector<MWWorld::Ptr>(), collisionType);
+            if (request.mRadius <= 0)
+                return rayCasting->castRay(from, to, request.mIgnore, std::vector<MWWorld::Ptr>(), request.mMask);
             else
+                return rayCasting->castSphere(from, to, request.mRadius, request.mMask);
+        };
+        api["castRays"] = [lua = context.mLua](const sol::table& rays, sol::optional<sol::table> options) {
+            std::vector<MWPhysics::RayCastingRequest> requests;
+            requests.reserve(rays.size());
+            for (std::size_t i = 1; i <= rays.size(); ++i)
             {
-                if (!ignore.isEmpty())
-                    throw std::logic_error("Currently castRay doesn't support `ignore` when radius > 0");
-                return rayCasting->castSphere(from, to, radius, collisionType);
+                const sol::table ray = rays.get<sol::table>(i);
+                requests.push_back(
+                    makeRayCastingRequest(ray.get<osg::Vec3f>("from"), ray.get<osg::Vec3f>("to"), options));
             }
+            std::vector<MWPhysics::RayCastingResult> results;
+            MWBase::Environment::get().getWorld()->getRayCasting()->castRays(requests, results);
+            sol::table res(lua->sol(), sol::create);
+            for (std::size_t i = 0; i < results.size(); ++i)
+                res[i + 1] = std::move(results[i]);
+            return res;
         };
         // TODO: async raycasting
         /*api["asyncCastRay"] = [luaManager = context.mLuaManager](
@@ -130,6 +156,29 @@ namespace MWLua
         api["doors"] = LObjectList{ worldView->getDoorsInScene() };
         api["items"] = LObjectList{ worldView->getItemsInScene() };
 
+        using ObjectGroupType = WorldView::ObjectGroupType;
+        api["OBJECT_GROUP"]
+            = LuaUtil::makeStrictReadOnly(context.mLua->tableFromPairs<std::string_view, ObjectGroupType>({
+                { "Activators", ObjectGroupType::Activators },
+                { "Actors", ObjectGroupType::Actors },
+                { "Containers", ObjectGroupType::Containers },
+                { "Doors", ObjectGroupType::Doors },
+                { "Items", ObjectGroupType::Items },
+            }));
+        api["findInRadius"] = [worldView](ObjectGroupType group, const osg::Vec3f& center, float radius) {
+            return LObjectList{ worldView->findInRadius(group, center, radius) };
+        };
+        api["findInBox"] = [worldView](ObjectGroupType group, const osg::Vec3f& min, const osg::Vec3f& max) {
+            return LObjectList{ worldView->findInBox(group, min, max) };
+        };
+        api["findNearest"] = [worldView](ObjectGroupType group, const osg::Vec3f& center, int count,
+                                 sol::optional<float> maxDistance) {
+            if (count < 0)
+                throw std::runtime_error("findNearest: count can not be negative");
+            return LObjectList{ worldView->findNearest(
+                group, center, count, maxDistance.value_or(std::numeric_limits<float>::max())) };
+        };
+
         api["NAVIGATOR_FLAGS"]
             = LuaUtil::makeStrictReadOnly(context.mLua->tableFromPairs<std::string_view, DetourNavigator::Flag>({
                 { "Walk", DetourNavigator::Flag_walk },
@@ -188,8 +188,9 @@ namespace MWLua
             objectT[sol::meta_function::equal_to] = [](const ObjectT& a, const ObjectT& b) { return a.id() == b.id(); };
             objectT[sol::meta_function::to_string] = &ObjectT::toString;
             objectT["sendEvent"] = [context](const ObjectT& dest, std::string eventName, const sol::object& eventData) {
-                context.mLocalEventQueue->push_back(
-                    { dest.id(), std::move(eventName), LuaUtil::serialize(eventData, context.mSerializer) });
+                LuaUtil::BinaryData data = context.mEventDataPool->acquire();
+                LuaUtil::serialize(data, eventData, context.mSerializer);
+                context.mLocalEventQueue->push_back({ dest.id(), std::move(eventName), std::move(data) });
             };
 
             objectT["activateBy"] = [context](const ObjectT& o, const ObjectT& actor) {
@@ -1,5 +1,7 @@
 #include "worldview.hpp"
 
+#include <algorithm>
+
 #include <components/esm3/esmreader.hpp>
 #include <components/esm3/esmwriter.hpp>
 #include <components/esm3/loadcell.hpp>
@@ -102,6 +104,7 @@ namespace MWLua
                 mList->push_back(id);
             mChanged = false;
         }
+        mGridIsValid = false;
     }
 
     void WorldView::ObjectGroup::clear()
@@ -109,6 +112,77 @@ namespace MWLua
         mChanged = false;
         mList->clear();
         mSet.clear();
+        mGrid.clear();
+        mGridIsValid = false;
+    }
+
+    const Misc::SpatialGrid<ObjectId>& WorldView::ObjectGroup::getGrid(ObjectRegistry& registry)
+    {
+        if (mGridIsValid)
+            return mGrid;
+        mGrid.clear();
+        for (const ObjectId& id : *mList)
+        {
+            const MWWorld::Ptr ptr = registry.getPtr(id, true);
+            if (!ptr.isEmpty())
+                mGrid.insert(ptr.getRefData().getPosition().asVec3(), id);
+        }
+        mGrid.build();
+        mGridIsValid = true;
+        return mGrid;
+    }
+
+    WorldView::ObjectGroup& WorldView::getGroup(ObjectGroupType type)
+    {
+        switch (type)
+        {
+            case ObjectGroupType::Activators:
+                return mActivatorsInScene;
+            case ObjectGroupType::Actors:
+                return mActorsInScene;
+            case ObjectGroupType::Containers:
+                return mContainersInScene;
+            case ObjectGroupType::Doors:
+                return mDoorsInScene;
+            case ObjectGroupType::Items:
+                return mItemsInScene;
+        }
+        throw std::logic_error("Invalid object group type: " + std::to_string(static_cast<int>(type)));
+    }
+
+    ObjectIdList WorldView::findInRadius(ObjectGroupType type, const osg::Vec3f& center, float radius)
+    {
+        std::vector<std::pair<float, ObjectId>> found;
+        getGroup(type).getGrid(mObjectRegistry).forEachInRadius(
+            center, radius, [&](const ObjectId& id, const osg::Vec3f& position) {
+                found.emplace_back((position - center).length2(), id);
+            });
+        std::sort(found.begin(), found.end(), [](const auto& l, const auto& r) { return l.first < r.first; });
+        ObjectIdList res = std::make_shared<std::vector<ObjectId>>();
+        res->reserve(found.size());
+        for (const auto& [distance, id] : found)
+            res->push_back(id);
+        return res;
+    }
+
+    ObjectIdList WorldView::findInBox(ObjectGroupType type, const osg::Vec3f& min, const osg::Vec3f& max)
+    {
+        ObjectIdList res = std::make_shared<std::vector<ObjectId>>();
+        getGroup(type).getGrid(mObjectRegistry).forEachInBox(
+            min, max, [&](const ObjectId& id, const osg::Vec3f&) { res->push_back(id); });
+        return res;
+    }
+
+    ObjectIdList WorldView::findNearest(
+        ObjectGroupType type, const osg::Vec3f& center, std::size_t count, float maxDistance)
+    {
+        std::vector<std::pair<float, ObjectId>> found;
+        getGroup(type).getGrid(mObjectRegistry).findNearest(center, count, maxDistance, found);
+        ObjectIdList res = std::make_shared<std::vector<ObjectId>>();
+        res->reserve(found.size());
+        for (const auto& [distance, id] : found)
+            res->push_back(id);
+        return res;
     }
 
     void WorldView::addToGroup(ObjectGroup& group, const MWWorld::Ptr& ptr)
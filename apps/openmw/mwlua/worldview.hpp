@@ -6,6 +6,8 @@
 #include "../mwbase/environment.hpp"
 #include "../mwbase/world.hpp"
 
+#include <components/misc/spatialgrid.hpp>
+
 #include <set>
 
 namespace ESM
@@ -43,6 +45,21 @@ namespace MWLua
         ObjectIdList getDoorsInScene() const { return mDoorsInScene.mList; }
         ObjectIdList getItemsInScene() const { return mItemsInScene.mList; }
 
+        enum class ObjectGroupType
+        {
+            Activators,
+            Actors,
+            Containers,
+            Doors,
+            Items,
+        };
+
+        // Spatial queries over objects in the scene. Positions are taken at the first query in a frame.
+        // Results of `findInRadius` and `findNearest` are sorted by distance.
+        ObjectIdList findInRadius(ObjectGroupType type, const osg::Vec3f& center, float radius);
+        ObjectIdList findInBox(ObjectGroupType type, const osg::Vec3f& min, const osg::Vec3f& max);
+        ObjectIdList findNearest(ObjectGroupType type, const osg::Vec3f& center, std::size_t count, float maxDistance);
+
         ObjectRegistry* getObjectRegistry() { return &mObjectRegistry; }
 
         void objectUnloaded(const MWWorld::Ptr& ptr) { mObjectRegistry.deregisterPtr(ptr); }
@@ -69,13 +86,19 @@ namespace MWLua
         {
             void updateList();
             void clear();
+            const Misc::SpatialGrid<ObjectId>& getGrid(ObjectRegistry& registry);
 
             bool mChanged = false;
             ObjectIdList mList = std::make_shared<std::vector<ObjectId>>();
             std::set<ObjectId> mSet;
+
+            // Rebuilt lazily at most once per frame.
+            Misc::SpatialGrid<ObjectId> mGrid{ 1024.f };
+            bool mGridIsValid = false;
         };
 
         ObjectGroup* chooseGroup(const MWWorld::Ptr& ptr);
+        ObjectGroup& getGroup(ObjectGroupType type);
         void addToGroup(ObjectGroup& group, const MWWorld::Ptr& ptr);
         void removeFromGroup(ObjectGroup& group, const MWWorld::Ptr& ptr);
 
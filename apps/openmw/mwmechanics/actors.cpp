@@ -247,19 +247,8 @@ namespace MWMechanics
             return (distanceToNextPathPoint - package.getNextPathPointTolerance(speed, duration, halfExtents)) / speed;
         }
 
-        void updateHeadTracking(const MWWorld::Ptr& actor, const MWWorld::Ptr& targetActor,
-            MWWorld::Ptr& headTrackTarget, float& sqrHeadTrackDistance, bool inCombatOrPursue)
+        float getMaxHeadTrackDistance(const MWWorld::Ptr& actor)
         {
-            const auto& actorRefData = actor.getRefData();
-            if (!actorRefData.getBaseNode())
-                return;
-
-            if (targetActor.getClass().getCreatureStats(targetActor).isDead())
-                return;
-
-            if (isTargetMagicallyHidden(targetActor))
-                return;
-
             static const float fMaxHeadTrackDistance = MWBase::Environment::get()
                                                            .getWorld()
                                                            ->getStore()
@@ -276,6 +265,23 @@ namespace MWMechanics
             const ESM::Cell* currentCell = actor.getCell()->getCell();
             if (!currentCell->isExterior() && !(currentCell->mData.mFlags & ESM::Cell::QuasiEx))
                 maxDistance *= fInteriorHeadTrackMult;
+            return maxDistance;
+        }
+
+        void updateHeadTracking(const MWWorld::Ptr& actor, const MWWorld::Ptr& targetActor,
+            MWWorld::Ptr& headTrackTarget, float& sqrHeadTrackDistance, bool inCombatOrPursue)
+        {
+            const auto& actorRefData = actor.getRefData();
+            if (!actorRefData.getBaseNode())
+                return;
+
+            if (targetActor.getClass().getCreatureStats(targetActor).isDead())
+                return;
+
+            if (isTargetMagicallyHidden(targetActor))
+                return;
+
+            const float maxDistance = getMaxHeadTrackDistance(actor);
 
             const osg::Vec3f actor1Pos(actorRefData.getPosition().asVec3());
             const osg::Vec3f actor2Pos(targetActor.getRefData().getPosition().asVec3());
@@ -299,8 +305,9 @@ namespace MWMechanics
             }
         }
 
-        void updateHeadTracking(
-            const MWWorld::Ptr& ptr, const std::list<Actor>& actors, bool isPlayer, CharacterController& ctrl)
+        // `neighbors` are the actors within getMaxHeadTrackDistance(ptr), others can't be tracked unless in combat.
+        void updateHeadTracking(const MWWorld::Ptr& ptr, const std::vector<const Actor*>& neighbors, bool isPlayer,
+            CharacterController& ctrl)
         {
             float sqrHeadTrackDistance = std::numeric_limits<float>::max();
             MWWorld::Ptr headTrackTarget;
@@ -327,13 +334,13 @@ namespace MWMechanics
                 else
                 {
                     // Find something nearby.
-                    for (const Actor& otherActor : actors)
+                    for (const Actor* otherActor : neighbors)
                     {
-                        if (otherActor.getPtr() == ptr)
+                        if (otherActor->getPtr() == ptr)
                             continue;
 
                         updateHeadTracking(
-                            ptr, otherActor.getPtr(), headTrackTarget, sqrHeadTrackDistance, inCombatOrPursue);
+                            ptr, otherActor->getPtr(), headTrackTarget, sqrHeadTrackDistance, inCombatOrPursue);
                     }
                 }
             }
@@ -1182,6 +1189,7 @@ namespace MWMechanics
             return;
         const auto it = mActors.emplace(mActors.end(), ptr, anim);
         mIndex.emplace(ptr.mRef, it);
+        mActorsGridIsValid = false;
 
         if (updateImmediately)
             it->getCharacterController().update(0);
@@ -1233,6 +1241,7 @@ namespace MWMechanics
                 removeTemporaryEffects(iter->second->getPtr());
             mActors.erase(iter->second);
             mIndex.erase(iter);
+            mActorsGridIsValid = false;
         }
     }
 
@@ -1278,7 +1287,10 @@ namespace MWMechanics
     {
         const auto iter = mIndex.find(old.mRef);
         if (iter != mIndex.end())
+        {
             iter->second->updatePtr(ptr);
+            mActorsGridIsValid = false;
+        }
     }
 
     void Actors::dropActors(const MWWorld::CellStore* cellStore, const MWWorld::Ptr& ignore)
@@ -1290,6 +1302,7 @@ namespace MWMechanics
                 removeTemporaryEffects(iter->getPtr());
                 mIndex.erase(iter->getPtr().mRef);
                 iter = mActors.erase(iter);
+                mActorsGridIsValid = false;
             }
             else
                 ++iter;
@@ -1534,6 +1547,11 @@ namespace MWMechanics
             }
             const bool godmode = MWBase::Environment::get().getWorld()->getGodModeState();
 
+            // Actors don't move until the physics update, so during the AI update neighbours are taken from the grid.
+            rebuildActorsGrid();
+            mUseActorsGrid = true;
+            std::vector<const Actor*> neighbors;
+
             // AI and magic effects update
             for (Actor& actor : mActors)
             {
@@ -1586,6 +1604,7 @@ namespace MWMechanics
 
                     if (!cellChanged && worldScene->hasCellChanged())
                     {
+                        mUseActorsGrid = false;
                         return; // for now abort update of the old cell when cell changes by teleportation magic effect
                                 // a better solution might be to apply cell changes at the end of the frame
                     }
@@ -1596,16 +1615,28 @@ namespace MWMechanics
                             if (!isPlayer)
                                 adjustCommandedActor(actor.getPtr());
 
-                            for (const Actor& otherActor : mActors)
+                            if (!isPlayer) // player is not AI-controlled
                             {
-                                if (otherActor.getPtr() == actor.getPtr() || isPlayer) // player is not AI-controlled
-                                    continue;
-                                engageCombat(
-                                    actor.getPtr(), otherActor.getPtr(), cachedAllies, otherActor.getPtr() == player);
+                                // Actors farther than the processing range are ignored by engageCombat anyway
+                                neighbors.clear();
+                                getActorsInRange(actorPtr.getRefData().getPosition().asVec3(),
+                                    mActorsProcessingRange, neighbors);
+                                for (const Actor* otherActor : neighbors)
+                                {
+                                    if (otherActor->getPtr() == actor.getPtr())
+                                        continue;
+                                    engageCombat(actor.getPtr(), otherActor->getPtr(), cachedAllies,
+                                        otherActor->getPtr() == player);
+                                }
                             }
                         }
                         if (mTimerUpdateHeadTrack == 0)
-                            updateHeadTracking(actor.getPtr(), mActors, isPlayer, ctrl);
+                        {
+                            neighbors.clear();
+                            getActorsInRange(actorPtr.getRefData().getPosition().asVec3(),
+                                getMaxHeadTrackDistance(actorPtr), neighbors);
+                            updateHeadTracking(actor.getPtr(), neighbors, isPlayer, ctrl);
+                        }
 
                         if (actor.getPtr().getClass().isNpc() && !isPlayer)
                             updateCrimePursuit(actor.getPtr(), duration);
@@ -1643,6 +1674,8 @@ namespace MWMechanics
                 }
             }
 
+            mUseActorsGrid = false;
+
             static const bool avoidCollisions = Settings::Manager::getBool("NPCs avoid collisions", "Game");
             if (avoidCollisions)
                 predictAndAvoidCollisions(duration);
@@ -2049,13 +2082,49 @@ namespace MWMechanics
             actor.getCharacterController().persistAnimationState();
     }
 
-    void Actors::getObjectsInRange(const osg::Vec3f& position, float radius, std::vector<MWWorld::Ptr>& out) const
+    void Actors::getActorsInRange(const osg::Vec3f& position, float radius, std::vector<const Actor*>& out) const
     {
+        if (!mUseActorsGrid)
+        {
+            for (const Actor& actor : mActors)
+            {
+                if ((actor.getPtr().getRefData().getPosition().asVec3() - position).length2() <= radius * radius)
+                    out.push_back(&actor);
+            }
+            return;
+        }
+
+        if (!mActorsGridIsValid)
+            rebuildActorsGrid();
+
+        mActorsGridQuery.clear();
+        mActorsGrid.forEachInRadius(
+            position, radius, [&](std::size_t index, const osg::Vec3f&) { mActorsGridQuery.push_back(index); });
+        // Keep the order of mActors to not make the result of AI processing depend on the grid layout
+        std::sort(mActorsGridQuery.begin(), mActorsGridQuery.end());
+        for (std::size_t index : mActorsGridQuery)
+            out.push_back(mActorsGridItems[index]);
+    }
+
+    void Actors::rebuildActorsGrid() const
+    {
+        mActorsGrid.clear();
+        mActorsGridItems.clear();
         for (const Actor& actor : mActors)
         {
-            if ((actor.getPtr().getRefData().getPosition().asVec3() - position).length2() <= radius * radius)
-                out.push_back(actor.getPtr());
+            mActorsGrid.insert(actor.getPtr().getRefData().getPosition().asVec3(), mActorsGridItems.size());
+            mActorsGridItems.push_back(&actor);
         }
+        mActorsGrid.build();
+        mActorsGridIsValid = true;
+    }
+
+    void Actors::getObjectsInRange(const osg::Vec3f& position, float radius, std::vector<MWWorld::Ptr>& out) const
+    {
+        std::vector<const Actor*> actors;
+        getActorsInRange(position, radius, actors);
+        for (const Actor* actor : actors)
+            out.push_back(actor->getPtr());
     }
 
     bool Actors::isAnyObjectInRange(const osg::Vec3f& position, float radius) const
@@ -2292,6 +2361,9 @@ namespace MWMechanics
         mIndex.clear();
         mActors.clear();
         mDeathCount.clear();
+        mActorsGrid.clear();
+        mActorsGridItems.clear();
+        mActorsGridIsValid = false;
     }
 
     void Actors::updateMagicEffects(const MWWorld::Ptr& ptr) const
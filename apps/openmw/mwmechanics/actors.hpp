@@ -7,6 +7,8 @@
 #include <string>
 #include <vector>
 
+#include <components/misc/spatialgrid.hpp>
+
 #include "actor.hpp"
 
 namespace ESM
@@ -190,6 +192,18 @@ namespace MWMechanics
         bool mSmoothMovement;
         MusicType mCurrentMusic = MusicType::Title;
 
+        // Actor positions for neighbourhood queries. Used only during the AI update when actors don't move;
+        // rebuilt at its start and when the set of actors changes.
+        mutable Misc::SpatialGrid<std::size_t> mActorsGrid{ 512.f };
+        mutable std::vector<const Actor*> mActorsGridItems;
+        mutable std::vector<std::size_t> mActorsGridQuery;
+        mutable bool mActorsGridIsValid = false;
+        bool mUseActorsGrid = false;
+
+        /// Appends actors within the sphere to \a out in the order of mActors.
+        void getActorsInRange(const osg::Vec3f& position, float radius, std::vector<const Actor*>& out) const;
+        void rebuildActorsGrid() const;
+
         void updateVisibility(const MWWorld::Ptr& ptr, CharacterController& ctrl) const;
 
         void adjustMagicEffects(const MWWorld::Ptr& creature, float duration) const;
@@ -119,6 +119,9 @@ bool MWMechanics::AiPackage::pathTo(const MWWorld::Ptr& actor, const osg::Vec3f&
     MWBase::World* world = MWBase::Environment::get().getWorld();
     const DetourNavigator::AgentBounds agentBounds = world->getPathfindingAgentBounds(actor);
 
+    if (mPathFinder.hasPendingPath())
+        mPathFinder.updatePendingPath(actor, getPathGridGraph(mPathFinder.getPendingPathCell()));
+
     /// Stops the actor when it gets too close to a unloaded cell
     //... At current time, this test is unnecessary. AI shuts down when actor is more than "actors processing range"
     // setting value
@@ -154,12 +157,13 @@ bool MWMechanics::AiPackage::pathTo(const MWWorld::Ptr& actor, const osg::Vec3f&
         {
             if (wasShortcutting || doesPathNeedRecalc(dest, actor)) // if need to rebuild path
             {
-                mPathFinder.buildLimitedPath(actor, position, dest, actor.getCell(), getPathGridGraph(actor.getCell()),
-                    agentBounds, getNavigatorFlags(actor), getAreaCosts(actor), endTolerance, pathType);
+                mPathFinder.requestLimitedPath(actor, position, dest, actor.getCell(),
+                    getPathGridGraph(actor.getCell()), agentBounds, getNavigatorFlags(actor), getAreaCosts(actor),
+                    endTolerance, pathType);
                 mRotateOnTheRunChecks = 3;
 
                 // give priority to go directly on target if there is minimal opportunity
-                if (destInLOS && mPathFinder.getPath().size() > 1)
+                if (destInLOS && !mPathFinder.hasPendingPath() && mPathFinder.getPath().size() > 1)
                 {
                     // get point just before dest
                     auto pPointBeforeDest = mPathFinder.getPath().rbegin() + 1;
@@ -329,8 +333,7 @@ const MWMechanics::PathgridGraph& MWMechanics::AiPackage::getPathGridGraph(const
     CacheMap::iterator found = cache.find(id);
     if (found == cache.end())
     {
-        cache.insert(
-            std::make_pair(id, std::make_unique<MWMechanics::PathgridGraph>(MWMechanics::PathgridGraph(cell))));
+        cache.insert(std::make_pair(id, std::make_unique<MWMechanics::PathgridGraph>(cell)));
     }
     return *cache[id].get();
 }
@@ -6,6 +6,7 @@
 #include <osg/io_utils>
 
 #include <components/debug/debuglog.hpp>
+#include <components/detournavigator/asyncpathfinder.hpp>
 #include <components/detournavigator/debug.hpp>
 #include <components/detournavigator/navigatorutils.hpp>
 #include <components/misc/coordinateconverter.hpp>
@@ -82,6 +83,27 @@ namespace
         return 2 * std::max(realHalfExtents.x(), realHalfExtents.y());
     }
 
+    void logBuildPathError(const MWWorld::ConstPtr& actor, DetourNavigator::Status status,
+        const osg::Vec3f& startPoint, const osg::Vec3f& endPoint, DetourNavigator::Flags flags)
+    {
+        Log(Debug::Debug) << "Build path by navigator error: \"" << DetourNavigator::getMessage(status) << "\" for \""
+                          << actor.getClass().getName(actor) << "\" (" << actor.getBase() << ") from " << startPoint
+                          << " to " << endPoint << " with flags (" << DetourNavigator::WriteFlags{ flags } << ")";
+    }
+
+    // Path is built only within the area covered by navmesh and not further than a cell.
+    osg::Vec3f getLimitedPathEnd(const osg::Vec3f& startPoint, const osg::Vec3f& endPoint)
+    {
+        const auto navigator = MWBase::Environment::get().getWorld()->getNavigator();
+        const auto maxDistance
+            = std::min(navigator->getMaxNavmeshAreaRealRadius(), static_cast<float>(Constants::CellSizeInUnits));
+        const auto startToEnd = endPoint - startPoint;
+        const auto distance = startToEnd.length();
+        if (distance <= maxDistance)
+            return endPoint;
+        return startPoint + startToEnd * maxDistance / distance;
+    }
+
     float getHeight(const MWWorld::ConstPtr& actor)
     {
         const auto world = MWBase::Environment::get().getWorld();
@@ -235,12 +257,13 @@ namespace MWMechanics
         else
         {
             auto path = pathgridGraph.aStarSearch(startNode, endNode.first);
+            auto pathBegin = path.begin();
 
             // If nearest path node is in opposite direction from second, remove it from path.
             // Especially useful for wandering actors, if the nearest node is blocked for some reason.
             if (path.size() > 1)
             {
-                ESM::Pathgrid::Point secondNode = *(++path.begin());
+                ESM::Pathgrid::Point secondNode = path[1];
                 osg::Vec3f firstNodeVec3f = makeOsgVec3(pathgrid->mPoints[startNode]);
                 osg::Vec3f secondNodeVec3f = makeOsgVec3(secondNode);
                 osg::Vec3f toSecondNodeVec3f = secondNodeVec3f - firstNodeVec3f;
@@ -259,12 +282,12 @@ namespace MWMechanics
                                                 osg::Vec3f(temp.mX, temp.mY, temp.mZ + 16), mask)
                                             .mHit;
                     if (isPathClear)
-                        path.pop_front();
+                        ++pathBegin;
                 }
             }
 
             // convert supplied path to world coordinates
-            std::transform(path.begin(), path.end(), out, [&](ESM::Pathgrid::Point& point) {
+            std::transform(pathBegin, path.end(), out, [&](ESM::Pathgrid::Point& point) {
                 converter.toWorld(point);
                 return makeOsgVec3(point);
             });
@@ -363,6 +386,7 @@ namespace MWMechanics
     void PathFinder::buildStraightPath(const osg::Vec3f& endPoint)
     {
         mPath.clear();
+        mPendingPath.reset();
         mPath.push_back(endPoint);
         mConstructed = true;
     }
@@ -371,6 +395,7 @@ namespace MWMechanics
         const MWWorld::CellStore* cell, const PathgridGraph& pathgridGraph)
     {
         mPath.clear();
+        mPendingPath.reset();
         mCell = cell;
 
         buildPathByPathgridImpl(startPoint, endPoint, pathgridGraph, std::back_inserter(mPath));
@@ -383,6 +408,7 @@ namespace MWMechanics
         const DetourNavigator::AreaCosts& areaCosts, float endTolerance, PathType pathType)
     {
         mPath.clear();
+        mPendingPath.reset();
 
         // If it's not possible to build path over navmesh due to disabled navmesh generation fallback to straight path
         DetourNavigator::Status status = buildPathByNavigatorImpl(actor, startPoint, endPoint, agentBounds, flags,
@@ -403,6 +429,7 @@ namespace MWMechanics
         const DetourNavigator::AreaCosts& areaCosts, float endTolerance, PathType pathType)
     {
         mPath.clear();
+        mPendingPath.reset();
         mCell = cell;
 
         DetourNavigator::Status status = DetourNavigator::Status::NavMeshNotFound;
@@ -415,6 +442,15 @@ namespace MWMechanics
                 mPath.clear();
         }
 
+        buildPathFallback(
+            actor, startPoint, endPoint, pathgridGraph, agentBounds, flags, areaCosts, endTolerance, pathType, status);
+    }
+
+    void PathFinder::buildPathFallback(const MWWorld::ConstPtr& actor, const osg::Vec3f& startPoint,
+        const osg::Vec3f& endPoint, const PathgridGraph& pathgridGraph, const DetourNavigator::AgentBounds& agentBounds,
+        const DetourNavigator::Flags flags, const DetourNavigator::AreaCosts& areaCosts, float endTolerance,
+        PathType pathType, DetourNavigator::Status status)
+    {
         if (status != DetourNavigator::Status::NavMeshNotFound && mPath.empty()
             && (flags & DetourNavigator::Flag_usePathgrid) == 0)
         {
@@ -449,12 +485,7 @@ namespace MWMechanics
             return DetourNavigator::Status::Success;
 
         if (status != DetourNavigator::Status::Success)
-        {
-            Log(Debug::Debug) << "Build path by navigator error: \"" << DetourNavigator::getMessage(status)
-                              << "\" for \"" << actor.getClass().getName(actor) << "\" (" << actor.getBase()
-                              << ") from " << startPoint << " to " << endPoint << " with flags ("
-                              << DetourNavigator::WriteFlags{ flags } << ")";
-        }
+            logBuildPathError(actor, status, startPoint, endPoint, flags);
 
         return status;
     }
@@ -484,10 +515,7 @@ namespace MWMechanics
 
         if (status != DetourNavigator::Status::Success)
         {
-            Log(Debug::Debug) << "Build path by navigator error: \"" << DetourNavigator::getMessage(status)
-                              << "\" for \"" << actor.getClass().getName(actor) << "\" (" << actor.getBase()
-                              << ") from " << startPoint << " to " << mPath.front() << " with flags ("
-                              << DetourNavigator::WriteFlags{ flags } << ")";
+            logBuildPathError(actor, status, startPoint, mPath.front(), flags);
             return;
         }
 
@@ -505,15 +533,65 @@ namespace MWMechanics
         const DetourNavigator::AgentBounds& agentBounds, const DetourNavigator::Flags flags,
         const DetourNavigator::AreaCosts& areaCosts, float endTolerance, PathType pathType)
     {
-        const auto navigator = MWBase::Environment::get().getWorld()->getNavigator();
-        const auto maxDistance
-            = std::min(navigator->getMaxNavmeshAreaRealRadius(), static_cast<float>(Constants::CellSizeInUnits));
-        const auto startToEnd = endPoint - startPoint;
-        const auto distance = startToEnd.length();
-        if (distance <= maxDistance)
-            return buildPath(actor, startPoint, endPoint, cell, pathgridGraph, agentBounds, flags, areaCosts,
+        buildPath(actor, startPoint, getLimitedPathEnd(startPoint, endPoint), cell, pathgridGraph, agentBounds, flags,
+            areaCosts, endTolerance, pathType);
+    }
+
+    void PathFinder::requestLimitedPath(const MWWorld::ConstPtr& actor, const osg::Vec3f& startPoint,
+        const osg::Vec3f& endPoint, const MWWorld::CellStore* cell, const PathgridGraph& pathgridGraph,
+        const DetourNavigator::AgentBounds& agentBounds, const DetourNavigator::Flags flags,
+        const DetourNavigator::AreaCosts& areaCosts, float endTolerance, PathType pathType)
+    {
+        DetourNavigator::AsyncPathFinder* const asyncPathFinder
+            = MWBase::Environment::get().getWorld()->getAsyncPathFinder();
+
+        if (asyncPathFinder == nullptr || actor.getClass().isPureWaterCreature(actor)
+            || actor.getClass().isPureFlyingCreature(actor))
+            return buildLimitedPath(actor, startPoint, endPoint, cell, pathgridGraph, agentBounds, flags, areaCosts,
                 endTolerance, pathType);
-        const auto end = startPoint + startToEnd * maxDistance / distance;
-        buildPath(actor, startPoint, end, cell, pathgridGraph, agentBounds, flags, areaCosts, endTolerance, pathType);
+
+        // Replacing a request in flight each time a moving destination changes would never give a path to a
+        // chasing actor. Its result is applied first and the caller requests again if the path is outdated.
+        if (mPendingPath.has_value() && mPendingPath->mCell == cell && mPendingPath->mFlags == flags
+            && mPendingPath->mPathType == pathType)
+            return;
+
+        const osg::Vec3f end = getLimitedPathEnd(startPoint, endPoint);
+        const DetourNavigator::PathRequest request{ agentBounds, getPathStepSize(actor), startPoint, end, flags,
+            areaCosts, endTolerance };
+
+        mPendingPath = PendingPath{ asyncPathFinder->request(request), startPoint, end, cell, agentBounds, flags,
+            areaCosts, endTolerance, pathType };
+
+        // The result is ready immediately when there is no navmesh.
+        updatePendingPath(actor, pathgridGraph);
+    }
+
+    bool PathFinder::updatePendingPath(const MWWorld::ConstPtr& actor, const PathgridGraph& pathgridGraph)
+    {
+        if (!mPendingPath.has_value() || !mPendingPath->mResult->isReady())
+            return false;
+
+        const PendingPath pending = std::move(*mPendingPath);
+        mPendingPath.reset();
+
+        mPath.clear();
+        mCell = pending.mCell;
+
+        const DetourNavigator::PathResult& result = *pending.mResult;
+        DetourNavigator::Status status = result.getStatus();
+
+        if (pending.mPathType == PathType::Partial && status == DetourNavigator::Status::PartialPath)
+            status = DetourNavigator::Status::Success;
+
+        if (status == DetourNavigator::Status::Success)
+            mPath.assign(result.getPath().begin(), result.getPath().end());
+        else
+            logBuildPathError(actor, status, pending.mStartPoint, pending.mEndPoint, pending.mFlags);
+
+        buildPathFallback(actor, pending.mStartPoint, pending.mEndPoint, pathgridGraph, pending.mAgentBounds,
+            pending.mFlags, pending.mAreaCosts, pending.mEndTolerance, pending.mPathType, status);
+
+        return true;
     }
 }
@@ -4,7 +4,10 @@
 #include <cassert>
 #include <deque>
 #include <iterator>
+#include <memory>
+#include <optional>
 
+#include <components/detournavigator/agentbounds.hpp>
 #include <components/detournavigator/areatype.hpp>
 #include <components/detournavigator/flags.hpp>
 #include <components/detournavigator/status.hpp>
@@ -20,7 +23,7 @@ namespace MWWorld
 
 namespace DetourNavigator
 {
-    struct AgentBounds;
+    class PathResult;
 }
 
 namespace MWMechanics
@@ -93,6 +96,7 @@ namespace MWMechanics
             mConstructed = false;
             mPath.clear();
             mCell = nullptr;
+            mPendingPath.reset();
         }
 
         void buildStraightPath(const osg::Vec3f& endPoint);
@@ -119,12 +123,32 @@ namespace MWMechanics
             const DetourNavigator::AgentBounds& agentBounds, const DetourNavigator::Flags flags,
             const DetourNavigator::AreaCosts& areaCosts, float endTolerance, PathType pathType);
 
+        /// Same as buildLimitedPath but path over navmesh is found in background if possible. The current path is
+        /// kept until the result is applied by updatePendingPath. A pending request in the same cell is not
+        /// replaced even if the destination has moved.
+        void requestLimitedPath(const MWWorld::ConstPtr& actor, const osg::Vec3f& startPoint,
+            const osg::Vec3f& endPoint, const MWWorld::CellStore* cell, const PathgridGraph& pathgridGraph,
+            const DetourNavigator::AgentBounds& agentBounds, const DetourNavigator::Flags flags,
+            const DetourNavigator::AreaCosts& areaCosts, float endTolerance, PathType pathType);
+
+        bool hasPendingPath() const { return mPendingPath.has_value(); }
+
+        const MWWorld::CellStore* getPendingPathCell() const
+        {
+            return mPendingPath.has_value() ? mPendingPath->mCell : nullptr;
+        }
+
+        /// Replaces the current path by the result of the pending request if it's ready.
+        /// @param pathgridGraph graph of the pending path cell used for fallback.
+        /// @return true if the path is replaced.
+        bool updatePendingPath(const MWWorld::ConstPtr& actor, const PathgridGraph& pathgridGraph);
+
         /// Remove front point if exist and within tolerance
         void update(const osg::Vec3f& position, float pointTolerance, float destinationTolerance,
             bool shortenIfAlmostStraight, bool canMoveByZ, const DetourNavigator::AgentBounds& agentBounds,
             const DetourNavigator::Flags flags);
 
-        bool checkPathCompleted() const { return mConstructed && mPath.empty(); }
+        bool checkPathCompleted() const { return mConstructed && mPath.empty() && !mPendingPath.has_value(); }
 
         /// In radians
         float getZAngleToNext(float x, float y) const;
@@ -201,11 +225,26 @@ namespace MWMechanics
         }
 
     private:
+        struct PendingPath
+        {
+            std::shared_ptr<const DetourNavigator::PathResult> mResult;
+            osg::Vec3f mStartPoint;
+            osg::Vec3f mEndPoint;
+            const MWWorld::CellStore* mCell;
+            DetourNavigator::AgentBounds mAgentBounds;
+            DetourNavigator::Flags mFlags;
+            DetourNavigator::AreaCosts mAreaCosts;
+            float mEndTolerance;
+            PathType mPathType;
+        };
+
         bool mConstructed;
         std::deque<osg::Vec3f> mPath;
 
         const MWWorld::CellStore* mCell;
 
+        std::optional<PendingPath> mPendingPath;
+
         void buildPathByPathgridImpl(const osg::Vec3f& startPoint, const osg::Vec3f& endPoint,
             const PathgridGraph& pathgridGraph, std::back_insert_iterator<std::deque<osg::Vec3f>> out);
 
@@ -213,6 +252,13 @@ namespace MWMechanics
             const osg::Vec3f& startPoint, const osg::Vec3f& endPoint, const DetourNavigator::AgentBounds& agentBounds,
             const DetourNavigator::Flags flags, const DetourNavigator::AreaCosts& areaCosts, float endTolerance,
             PathType pathType, std::back_insert_iterator<std::deque<osg::Vec3f>> out);
+
+        // Tries the rest of the ways to build the path when the navmesh query with given flags gave status.
+        void buildPathFallback(const MWWorld::ConstPtr& actor, const osg::Vec3f& startPoint,
+            const osg::Vec3f& endPoint, const PathgridGraph& pathgridGraph,
+            const DetourNavigator::AgentBounds& agentBounds, const DetourNavigator::Flags flags,
+            const DetourNavigator::AreaCosts& areaCosts, float endTolerance, PathType pathType,
+            DetourNavigator::Status status);
     };
 }
 
@@ -1,5 +1,7 @@
 #include "pathgrid.hpp"
 
+#include <algorithm>
+
 #include "../mwbase/environment.hpp"
 #include "../mwbase/world.hpp"
 
@@ -124,6 +126,7 @@ namespace MWMechanics
             // mGraph[mPathgrid->mEdges[i].mV1].edges.push_back(neighbour);
         }
         buildConnectedPoints();
+        clearPathCache();
         mIsGraphConstructed = true;
         return true;
     }
@@ -224,6 +227,12 @@ namespace MWMechanics
         }
     }
 
+    void PathgridGraph::clearPathCache()
+    {
+        const std::lock_guard lock(mPathCacheMutex);
+        mPathCache.fill(CachedPath{});
+    }
+
     /*
      * NOTE: Based on buildPath2(), please check git history if interested
      *       Should consider using a 3rd party library version (e.g. boost)
@@ -232,101 +241,151 @@ namespace MWMechanics
      * Uses mGraph which has pre-computed costs for allowed edges.  It is assumed
      * that mGraph is already constructed.
      *
-     * Should be possible to make this MT safe.
-     *
      * Returns path which may be empty.  path contains pathgrid points in local
      * cell coordinates (indoors) or world coordinates (external).
      *
      * Input params:
      *   start, goal - pathgrid point indexes (for this cell)
      *
-     * Variables:
-     *   openset - point indexes to be traversed, lowest cost at the front
-     *   closedset - point indexes already traversed
-     *   gScore - past accumulated costs vector indexed by point index
-     *   fScore - future estimated costs vector indexed by point index
-     *
-     * TODO: An intersting exercise might be to cache the paths created for a
-     *       start/goal pair.  To cache the results the paths need to be in
-     *       pathgrid points form (currently they are converted to world
-     *       coordinates).  Essentially trading speed w/ memory.
+     * Paths are cached by start/goal pair in pathgrid points form. Pathgrids
+     * never change during runtime, the cache is reset only when the graph is
+     * loaded.
      */
-    std::deque<ESM::Pathgrid::Point> PathgridGraph::aStarSearch(const int start, const int goal) const
+    std::vector<ESM::Pathgrid::Point> PathgridGraph::aStarSearch(const int start, const int goal) const
     {
-        std::deque<ESM::Pathgrid::Point> path;
+        std::vector<ESM::Pathgrid::Point> path;
         if (!isPointConnected(start, goal))
         {
             return path; // there is no path, return an empty path
         }
 
-        int graphSize = static_cast<int>(mGraph.size());
-        std::vector<float> gScore(graphSize, -1);
-        std::vector<float> fScore(graphSize, -1);
-        std::vector<int> graphParent(graphSize, -1);
+        thread_local std::vector<int> indexes;
+        CachedPath& cached = mPathCache[(static_cast<std::size_t>(start) * 31 + goal) % mPathCache.size()];
+        bool found = false;
+        {
+            const std::lock_guard lock(mPathCacheMutex);
+            if (cached.mStart == start && cached.mGoal == goal)
+            {
+                indexes = cached.mPath;
+                found = true;
+            }
+        }
+        if (!found)
+        {
+            findPath(start, goal, indexes);
+            const std::lock_guard lock(mPathCacheMutex);
+            cached.mStart = start;
+            cached.mGoal = goal;
+            cached.mPath = indexes;
+        }
+
+        path.reserve(indexes.size());
+        for (int index : indexes)
+            path.push_back(mPathgrid->mPoints[index]);
+        return path;
+    }
+
+    /*
+     * A* over mGraph using a binary heap as the open set. A point is closed
+     * when it's taken from the heap for the first time. When a shorter way to
+     * an open point is found the point is pushed again, outdated heap entries
+     * are skipped when they reach the top.
+     *
+     * Scratch state is kept per thread and reused by the following searches,
+     * instead of clearing it the generation is increased.
+     */
+    void PathgridGraph::findPath(int start, int goal, std::vector<int>& path) const
+    {
+        struct PointState
+        {
+            unsigned generation = 0;
+            bool closed = false;
+            float gScore = 0;
+            int parent = -1;
+        };
+
+        struct OpenPoint
+        {
+            float fScore;
+            unsigned order; // keeps the order of points with the same cost independent of the heap layout
+            int index;
+        };
+
+        struct Scratch
+        {
+            std::vector<PointState> points;
+            std::vector<OpenPoint> openset;
+            unsigned generation = 0;
+        };
+
+        thread_local Scratch scratch;
+
+        path.clear();
 
-        // gScore & fScore keep costs for each pathgrid point in mPoints
-        gScore[start] = 0;
-        fScore[start] = costAStar(mPathgrid->mPoints[start], mPathgrid->mPoints[goal]);
+        if (scratch.points.size() < mGraph.size())
+            scratch.points.resize(mGraph.size());
+        if (++scratch.generation == 0)
+        {
+            for (PointState& point : scratch.points)
+                point.generation = 0;
+            scratch.generation = 1;
+        }
+        const unsigned generation = scratch.generation;
+        std::vector<PointState>& points = scratch.points;
+        std::vector<OpenPoint>& openset = scratch.openset;
+        openset.clear();
+
+        const auto greater = [](const OpenPoint& l, const OpenPoint& r) {
+            return l.fScore > r.fScore || (l.fScore == r.fScore && l.order > r.order);
+        };
+        unsigned order = 0;
 
-        std::list<int> openset;
-        std::list<int> closedset;
-        openset.push_back(start);
+        points[start] = PointState{ generation, false, 0, -1 };
+        openset.push_back(
+            OpenPoint{ costAStar(mPathgrid->mPoints[start], mPathgrid->mPoints[goal]), order++, start });
 
         int current = -1;
 
         while (!openset.empty())
         {
-            current = openset.front(); // front has the lowest cost
-            openset.pop_front();
+            std::pop_heap(openset.begin(), openset.end(), greater);
+            current = openset.back().index;
+            openset.pop_back();
+
+            if (points[current].closed)
+                continue; // outdated entry, the point was reached in a cheaper way
 
             if (current == goal)
                 break;
 
-            closedset.push_back(current); // remember we've been here
+            points[current].closed = true; // remember we've been here
 
             // check all edges for the current point index
-            for (int j = 0; j < static_cast<int>(mGraph[current].edges.size()); j++)
+            for (const ConnectedPoint& edge : mGraph[current].edges)
             {
-                if (std::find(closedset.begin(), closedset.end(), mGraph[current].edges[j].index) == closedset.end())
+                PointState& dest = points[edge.index];
+                const bool visited = dest.generation == generation;
+                if (visited && dest.closed)
+                    continue;
+
+                const float tentativeG = points[current].gScore + edge.cost;
+                if (!visited || tentativeG < dest.gScore)
                 {
-                    // not in closedset - i.e. have not traversed this edge destination
-                    int dest = mGraph[current].edges[j].index;
-                    float tentative_g = gScore[current] + mGraph[current].edges[j].cost;
-                    bool isInOpenSet = std::find(openset.begin(), openset.end(), dest) != openset.end();
-                    if (!isInOpenSet || tentative_g < gScore[dest])
-                    {
-                        graphParent[dest] = current;
-                        gScore[dest] = tentative_g;
-                        fScore[dest] = tentative_g + costAStar(mPathgrid->mPoints[dest], mPathgrid->mPoints[goal]);
-                        if (!isInOpenSet)
-                        {
-                            // add this edge to openset, lowest cost goes to the front
-                            // TODO: if this causes performance problems a hash table may help
-                            std::list<int>::iterator it = openset.begin();
-                            for (it = openset.begin(); it != openset.end(); ++it)
-                            {
-                                if (fScore[*it] > fScore[dest])
-                                    break;
-                            }
-                            openset.insert(it, dest);
-                        }
-                    }
-                } // if in closedset, i.e. traversed this edge already, try the next edge
+                    dest = PointState{ generation, false, tentativeG, current };
+                    const float fScore
+                        = tentativeG + costAStar(mPathgrid->mPoints[edge.index], mPathgrid->mPoints[goal]);
+                    openset.push_back(OpenPoint{ fScore, order++, edge.index });
+                    std::push_heap(openset.begin(), openset.end(), greater);
+                }
             }
         }
 
         if (current != goal)
-            return path; // for some reason couldn't build a path
+            return; // for some reason couldn't build a path
 
-        // reconstruct path to return, using local coordinates
-        while (graphParent[current] != -1)
-        {
-            path.push_front(mPathgrid->mPoints[current]);
-            current = graphParent[current];
-        }
-
-        // add first node to path explicitly
-        path.push_front(mPathgrid->mPoints[start]);
-        return path;
+        // reconstruct path to return
+        for (int point = goal; point != -1; point = points[point].parent)
+            path.push_back(point);
+        std::reverse(path.begin(), path.end());
     }
 }
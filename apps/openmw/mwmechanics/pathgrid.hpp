@@ -1,7 +1,9 @@
 #ifndef GAME_MWMECHANICS_PATHGRID_H
 #define GAME_MWMECHANICS_PATHGRID_H
 
-#include <deque>
+#include <array>
+#include <mutex>
+#include <vector>
 
 #include <components/esm3/loadpgrd.hpp>
 
@@ -22,6 +24,9 @@ namespace MWMechanics
     public:
         PathgridGraph(const MWWorld::CellStore* cell);
 
+        PathgridGraph(const PathgridGraph&) = delete;
+        PathgridGraph& operator=(const PathgridGraph&) = delete;
+
         bool load(const MWWorld::CellStore* cell);
 
         const ESM::Pathgrid* getPathgrid() const;
@@ -38,7 +43,9 @@ namespace MWMechanics
         // cells) coordinates
         //
         // NOTE: if start equals end an empty path is returned
-        std::deque<ESM::Pathgrid::Point> aStarSearch(const int start, const int end) const;
+        //
+        // Thread safe. Recently found paths are cached.
+        std::vector<ESM::Pathgrid::Point> aStarSearch(const int start, const int end) const;
 
     private:
         const ESM::Cell* mCell;
@@ -77,6 +84,20 @@ namespace MWMechanics
         // methods used to calculate connected components
         void recursiveStrongConnect(int v);
         void buildConnectedPoints();
+
+        // pathgrid point indexes from start to goal, empty if there is no path
+        void findPath(int start, int goal, std::vector<int>& path) const;
+
+        // Direct mapped cache of recently found paths, a new path replaces the one with the same slot.
+        struct CachedPath
+        {
+            int mStart = -1;
+            int mGoal = -1;
+            std::vector<int> mPath;
+        };
+        mutable std::mutex mPathCacheMutex;
+        mutable std::array<CachedPath, 64> mPathCache;
+        void clearPathCache();
     };
 }
 
@@ -115,6 +115,8 @@ namespace MWPhysics
 
     void Actor::enableCollisionMode(bool collision)
     {
+        if (mInternalCollisionMode != collision)
+            wakeUp();
         mInternalCollisionMode = collision;
     }
 
@@ -122,6 +124,7 @@ namespace MWPhysics
     {
         if (mExternalCollisionMode != collision)
         {
+            wakeUp();
             mExternalCollisionMode = collision;
             updateCollisionMask();
         }
@@ -157,6 +160,7 @@ namespace MWPhysics
         mPositionOffset = osg::Vec3f();
         mStandingOnPtr = nullptr;
         mSkipSimulation = true;
+        wakeUp();
     }
 
     void Actor::setSimulationPosition(const osg::Vec3f& position)
@@ -212,6 +216,7 @@ namespace MWPhysics
     {
         std::scoped_lock lock(mPositionMutex);
         mPositionOffset += offset;
+        wakeUp();
     }
 
     void Actor::applyOffsetChange()
@@ -229,6 +234,7 @@ namespace MWPhysics
     {
         std::scoped_lock lock(mPositionMutex);
         mRotation = quat;
+        wakeUp();
     }
 
     bool Actor::isRotationallyInvariant() const
@@ -240,6 +246,7 @@ namespace MWPhysics
     {
         std::scoped_lock lock(mPositionMutex);
         updateScaleUnsafe();
+        wakeUp();
     }
 
     void Actor::updateScaleUnsafe()
@@ -317,6 +324,21 @@ namespace MWPhysics
         mStandingOnPtr = ptr;
     }
 
+    void Actor::updateSleeping(bool idle, float waterlevel)
+    {
+        // A few frames are required to let the actor settle on the ground after a movement
+        constexpr unsigned int framesBeforeSleep = 10;
+        if (!idle)
+        {
+            wakeUp();
+            return;
+        }
+        if (mSleeping || ++mIdleFrames < framesBeforeSleep)
+            return;
+        mSleeping = true;
+        mSleepingWaterLevel = waterlevel;
+    }
+
     bool Actor::canMoveToWaterSurface(float waterlevel, const btCollisionWorld* world) const
     {
         const float halfZ = getHalfExtents().z();
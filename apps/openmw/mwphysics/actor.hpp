@@ -144,7 +144,27 @@ namespace MWPhysics
 
         bool isActive() const { return mActive; }
 
-        void setActive(bool value) { mActive = value; }
+        void setActive(bool value)
+        {
+            if (mActive != value)
+                wakeUp();
+            mActive = value;
+        }
+
+        /// Sleeping actor is excluded from the simulation until something may move it.
+        bool isSleeping() const { return mSleeping; }
+
+        /// Returns the water level the actor was put to sleep with.
+        float getSleepingWaterLevel() const { return mSleepingWaterLevel; }
+
+        /// Counts consecutive idle simulation frames and puts the actor to sleep after enough of them.
+        void updateSleeping(bool idle, float waterlevel);
+
+        void wakeUp()
+        {
+            mSleeping = false;
+            mIdleFrames = 0;
+        }
 
         DetourNavigator::CollisionShapeType getCollisionShapeType() const { return mCollisionShapeType; }
 
@@ -189,6 +209,9 @@ namespace MWPhysics
         bool mInternalCollisionMode;
         bool mExternalCollisionMode;
         bool mActive;
+        bool mSleeping = false;
+        unsigned int mIdleFrames = 0;
+        float mSleepingWaterLevel = 0;
 
         PhysicsTaskScheduler* mTaskScheduler;
 
@@ -11,6 +11,7 @@
 #include <LinearMath/btTransform.h>
 
 #include <type_traits>
+#include <utility>
 
 #if BT_BULLET_VERSION < 310
 // Older Bullet versions only support `btScalar` heightfields.
@@ -52,15 +53,17 @@ namespace
 
 namespace MWPhysics
 {
-    HeightField::HeightField(const float* heights, int x, int y, int size, int verts, float minH, float maxH,
-        const osg::Object* holdObject, PhysicsTaskScheduler* scheduler)
+    HeightFieldShape::HeightFieldShape(
+        const float* heights, int size, int verts, float minH, float maxH, const osg::Object* holdObject)
         : mHoldObject(holdObject)
-#if BT_BULLET_VERSION < 310
-        , mHeights(makeHeights(heights, verts))
-#endif
-        , mTaskScheduler(scheduler)
     {
+        if (holdObject == nullptr)
+        {
+            mOwnHeights.assign(heights, heights + static_cast<std::ptrdiff_t>(verts * verts));
+            heights = mOwnHeights.data();
+        }
 #if BT_BULLET_VERSION < 310
+        mHeights = makeHeights(heights, verts);
         mShape = std::make_unique<btHeightfieldTerrainShape>(
             verts, verts, getHeights(heights, mHeights), 1, minH, maxH, 2, PHY_FLOAT, false);
 #else
@@ -79,12 +82,20 @@ namespace MWPhysics
         // https://github.com/bulletphysics/bullet3/issues/3276
         mShape->buildAccelerator();
 #endif
+    }
 
+    HeightFieldShape::~HeightFieldShape() = default;
+
+    HeightField::HeightField(std::shared_ptr<const HeightFieldShape> shape, int x, int y, int size, float minH,
+        float maxH, PhysicsTaskScheduler* scheduler)
+        : mShape(std::move(shape))
+        , mTaskScheduler(scheduler)
+    {
         const btTransform transform(
             btQuaternion::getIdentity(), BulletHelpers::getHeightfieldShift(x, y, size, minH, maxH));
 
         mCollisionObject = std::make_unique<btCollisionObject>();
-        mCollisionObject->setCollisionShape(mShape.get());
+        mCollisionObject->setCollisionShape(mShape->get());
         mCollisionObject->setWorldTransform(transform);
         mTaskScheduler->addCollisionObject(
             mCollisionObject.get(), CollisionType_HeightMap, CollisionType_Actor | CollisionType_Projectile);
@@ -107,6 +118,6 @@ namespace MWPhysics
 
     const btHeightfieldTerrainShape* HeightField::getShape() const
     {
-        return mShape.get();
+        return mShape->get();
     }
 }
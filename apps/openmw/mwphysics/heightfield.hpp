@@ -20,11 +20,34 @@ namespace MWPhysics
 {
     class PhysicsTaskScheduler;
 
+    // Heightfield collision shape with its data, can be shared by heightfields of several cells with the same heights
+    class HeightFieldShape
+    {
+    public:
+        HeightFieldShape(
+            const float* heights, int size, int verts, float minH, float maxH, const osg::Object* holdObject);
+        ~HeightFieldShape();
+
+        btHeightfieldTerrainShape* get() const { return mShape.get(); }
+
+    private:
+        std::unique_ptr<btHeightfieldTerrainShape> mShape;
+        osg::ref_ptr<const osg::Object> mHoldObject;
+        // Copy of heights when there is no object to hold them, the shape may outlive the data provider
+        std::vector<float> mOwnHeights;
+#if BT_BULLET_VERSION < 310
+        std::vector<btScalar> mHeights;
+#endif
+
+        void operator=(const HeightFieldShape&);
+        HeightFieldShape(const HeightFieldShape&);
+    };
+
     class HeightField
     {
     public:
-        HeightField(const float* heights, int x, int y, int size, int verts, float minH, float maxH,
-            const osg::Object* holdObject, PhysicsTaskScheduler* scheduler);
+        HeightField(std::shared_ptr<const HeightFieldShape> shape, int x, int y, int size, float minH, float maxH,
+            PhysicsTaskScheduler* scheduler);
         ~HeightField();
 
         btCollisionObject* getCollisionObject();
@@ -32,12 +55,8 @@ namespace MWPhysics
         const btHeightfieldTerrainShape* getShape() const;
 
     private:
-        std::unique_ptr<btHeightfieldTerrainShape> mShape;
+        std::shared_ptr<const HeightFieldShape> mShape;
         std::unique_ptr<btCollisionObject> mCollisionObject;
-        osg::ref_ptr<const osg::Object> mHoldObject;
-#if BT_BULLET_VERSION < 310
-        std::vector<btScalar> mHeights;
-#endif
 
         PhysicsTaskScheduler* mTaskScheduler;
 
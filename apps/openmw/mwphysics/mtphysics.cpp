@@ -1,11 +1,13 @@
 #include "mtphysics.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <functional>
 #include <mutex>
 #include <optional>
 #include <shared_mutex>
 #include <variant>
+#include <vector>
 
 #include <BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
 #include <BulletCollision/CollisionShapes/btCollisionShape.h>
@@ -31,6 +33,7 @@
 #include "contacttestwrapper.h"
 #include "movementsolver.hpp"
 #include "object.hpp"
+#include "physicsreplay.hpp"
 #include "physicssystem.hpp"
 #include "projectile.hpp"
 
@@ -111,6 +114,10 @@ namespace
         std::variant<std::monostate, std::unique_lock<Mutex>, std::shared_lock<Mutex>> mImpl;
     };
 
+    // Sweeping a projectile is cheap compared to taking the collision world lock, so projectiles are moved in
+    // batches of this size by a single job
+    constexpr int projectilesBatchSize = 16;
+
     bool isUnderWater(const MWPhysics::ActorFrameData& actorData)
     {
         return actorData.mPosition.z() < actorData.mSwimLevel;
@@ -231,6 +238,27 @@ namespace
             }
         };
 
+        struct MoveProjectiles
+        {
+            const Move& mImpl;
+            std::shared_mutex& mCollisionWorldMutex;
+            const unsigned mNumThreads;
+
+            void operator()(MWPhysics::Simulation* begin, MWPhysics::Simulation* end) const
+            {
+                std::vector<LockedProjectileSimulation> locked;
+                locked.reserve(static_cast<std::size_t>(end - begin));
+                for (MWPhysics::Simulation* sim = begin; sim != end; ++sim)
+                    if (auto projectile = std::get<MWPhysics::ProjectileSimulation>(*sim).lock())
+                        locked.push_back(*std::move(projectile));
+                // Locked shared_ptrs have to be destructed after releasing mCollisionWorldMutex to avoid
+                // possible deadlock. Ptr destructor also acquires mCollisionWorldMutex.
+                const MaybeLock<std::shared_mutex> lock(mCollisionWorldMutex, mNumThreads);
+                for (const LockedProjectileSimulation& sim : locked)
+                    mImpl(sim);
+            }
+        };
+
         struct Sync
         {
             const bool mAdvanceSimulation;
@@ -273,8 +301,19 @@ namespace
                     actor->setOnSlope(frameData.mIsOnSlope);
                     actor->setWalkingOnWater(frameData.mWalkingOnWater);
                     actor->setInertialForce(frameData.mInertia);
+                    actor->updateSleeping(isIdle(*actor, frameData), frameData.mWaterlevel);
                 }
             }
+            bool isIdle(const MWPhysics::Actor& actor, const MWPhysics::ActorFrameData& frameData) const
+            {
+                // Only an actor resting on something that can't move by itself may be left out of the simulation
+                return frameData.mMovement.length2() == 0 && frameData.mInertia.length2() == 0
+                    && frameData.mWasOnGround && frameData.mIsOnGround && !frameData.mIsOnSlope
+                    && !frameData.mWalkingOnWater && !frameData.mFlying && !frameData.mSkipCollisionDetection
+                    && !isUnderWater(frameData) && frameData.mStuckFrames == 0
+                    && (actor.getPosition() - actor.getPreviousPosition()).length2() < 1e-4
+                    && scheduler->isStaticSupport(frameData.mStandingOn) && actor.getPtr() != MWMechanics::getPlayer();
+            }
             void operator()(MWPhysics::ProjectileSimulation& sim) const
             {
                 auto locked = sim.lock();
@@ -288,16 +327,20 @@ namespace
 
     namespace Config
     {
+        bool isBulletThreadSafe()
+        {
+            auto broad = std::make_unique<btDbvtBroadphase>();
+            auto maxSupportedThreads = broad->m_rayTestStacks.size();
+            return maxSupportedThreads > 1;
+        }
+
         /// @return either the number of thread as configured by the user, or 1 if Bullet doesn't support multithreading
         /// and user requested more than 1 background threads
         unsigned computeNumThreads()
         {
             int wantedThread = Settings::Manager::getInt("async num threads", "Physics");
 
-            auto broad = std::make_unique<btDbvtBroadphase>();
-            auto maxSupportedThreads = broad->m_rayTestStacks.size();
-            auto threadSafeBullet = (maxSupportedThreads > 1);
-            if (!threadSafeBullet && wantedThread > 1)
+            if (!isBulletThreadSafe() && wantedThread > 1)
             {
                 Log(Debug::Warning)
                     << "Bullet was not compiled with multithreading support, 1 async thread will be used";
@@ -305,6 +348,25 @@ namespace
             }
             return static_cast<unsigned>(std::max(0, wantedThread));
         }
+
+        /// @return number of threads to process batches of queries in addition to the calling thread, concurrent
+        /// queries are possible only when Bullet is thread safe which is the case for more than 1 physics thread
+        unsigned computeNumQueryThreads(unsigned numThreads)
+        {
+            return numThreads > 1 ? numThreads - 1 : 0;
+        }
+
+        /// @return threads counts to replay physics with: 1 and then powers of 2 up to the number of hardware
+        /// threads, concurrent replay is possible only when Bullet is thread safe
+        std::vector<unsigned> computeReplayThreadsCounts()
+        {
+            std::vector<unsigned> result{ 1 };
+            if (!isBulletThreadSafe())
+                return result;
+            for (unsigned threads = 2; threads <= std::thread::hardware_concurrency(); threads *= 2)
+                result.push_back(threads);
+            return result;
+        }
     }
 }
 
@@ -319,6 +381,7 @@ namespace MWPhysics
         , mDebugDrawer(debugDrawer)
         , mNumThreads(Config::computeNumThreads())
         , mNumJobs(0)
+        , mProjectilesBegin(0)
         , mRemainingSteps(0)
         , mLOSCacheExpiry(Settings::Manager::getInt("lineofsight keep inactive cache", "Physics"))
         , mFrameCounter(0)
@@ -326,6 +389,7 @@ namespace MWPhysics
         , mQuit(false)
         , mNextJob(0)
         , mNextLOS(0)
+        , mQueryThreads(Config::computeNumQueryThreads(mNumThreads))
         , mFrameNumber(0)
         , mTimer(osg::Timer::instance())
         , mPrevStepCount(1)
@@ -352,6 +416,9 @@ namespace MWPhysics
         mPostStepBarrier = std::make_unique<Misc::Barrier>(mNumThreads);
 
         mPostSimBarrier = std::make_unique<Misc::Barrier>(mNumThreads);
+
+        if (const int replayFrames = Settings::Manager::getInt("replay benchmark frames", "Physics"); replayFrames > 0)
+            mReplay = std::make_unique<PhysicsReplay>(static_cast<std::size_t>(replayFrames));
     }
 
     PhysicsTaskScheduler::~PhysicsTaskScheduler()
@@ -454,13 +521,29 @@ namespace MWPhysics
         mSimulations = &simulations;
         mAdvanceSimulation = (mRemainingSteps != 0);
         ++mFrameCounter;
-        mNumJobs = mSimulations->size();
+        // Projectiles simulations follow actors ones and are split into batches, each batch is a single job
+        mProjectilesBegin = static_cast<int>(
+            std::find_if(simulations.begin(), simulations.end(),
+                [](const Simulation& sim) { return std::holds_alternative<ProjectileSimulation>(sim); })
+            - simulations.begin());
+        const int numProjectiles = static_cast<int>(simulations.size()) - mProjectilesBegin;
+        mNumJobs = mProjectilesBegin + (numProjectiles + projectilesBatchSize - 1) / projectilesBatchSize;
         mNextLOS.store(0, std::memory_order_relaxed);
         mNextJob.store(0, std::memory_order_release);
 
         if (mAdvanceSimulation)
             mWorldFrameData = std::make_unique<WorldFrameData>();
 
+        if (mReplay != nullptr && mAdvanceSimulation)
+        {
+            mReplay->record(simulations, numSteps, newDelta, *mWorldFrameData);
+            if (mReplay->isComplete())
+            {
+                runReplay();
+                mReplay.reset();
+            }
+        }
+
         if (mAdvanceSimulation)
             mBudgetCursor += 1;
 
@@ -511,6 +594,24 @@ namespace MWPhysics
         mCollisionWorld->convexSweepTest(castShape, from, to, resultCallback);
     }
 
+    void PhysicsTaskScheduler::batchTest(
+        std::size_t count, const std::function<void(const btCollisionWorld&, std::size_t)>& test) const
+    {
+        // Waking up the query threads costs more than a few queries
+        constexpr std::size_t minParallelCount = 8;
+        MaybeLock lock(mCollisionWorldMutex, mNumThreads);
+        const btCollisionWorld& collisionWorld = *mCollisionWorld;
+        // Query threads are busy with a batch from another thread (e.g. Lua), run this one in the calling thread
+        std::unique_lock queryThreadsLock(mQueryThreadsMutex, std::try_to_lock);
+        if (count < minParallelCount || mQueryThreads.getThreadsCount() == 0 || !queryThreadsLock.owns_lock())
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                test(collisionWorld, i);
+            return;
+        }
+        mQueryThreads.forEach(count, [&](std::size_t i) { test(collisionWorld, i); });
+    }
+
     void PhysicsTaskScheduler::contactTest(
         btCollisionObject* colObj, btCollisionWorld::ContactResultCallback& resultCallback)
     {
@@ -549,6 +650,13 @@ namespace MWPhysics
         obj->getCollisionShape()->getAabb(obj->getWorldTransform(), min, max);
     }
 
+    void PhysicsTaskScheduler::getAabb(
+        const btCollisionObject* obj, const btTransform& transform, btVector3& min, btVector3& max)
+    {
+        MaybeSharedLock lock(mCollisionWorldMutex, mNumThreads);
+        obj->getCollisionShape()->getAabb(transform, min, max);
+    }
+
     void PhysicsTaskScheduler::setCollisionFilterMask(btCollisionObject* collisionObject, int collisionFilterMask)
     {
         MaybeExclusiveLock lock(mCollisionWorldMutex, mNumThreads);
@@ -699,8 +807,18 @@ namespace MWPhysics
             int job = 0;
             const Visitors::Move impl{ mPhysicsDt, mCollisionWorld, *mWorldFrameData };
             const Visitors::WithLockedPtr<Visitors::Move, MaybeLock> vis{ impl, mCollisionWorldMutex, mNumThreads };
+            const Visitors::MoveProjectiles moveProjectiles{ impl, mCollisionWorldMutex, mNumThreads };
             while ((job = mNextJob.fetch_add(1, std::memory_order_relaxed)) < mNumJobs)
-                std::visit(vis, (*mSimulations)[job]);
+            {
+                if (job < mProjectilesBegin)
+                {
+                    std::visit(vis, (*mSimulations)[job]);
+                    continue;
+                }
+                const int begin = mProjectilesBegin + (job - mProjectilesBegin) * projectilesBatchSize;
+                const int end = std::min(begin + projectilesBatchSize, static_cast<int>(mSimulations->size()));
+                moveProjectiles(mSimulations->data() + begin, mSimulations->data() + end);
+            }
 
             mPostStepBarrier->wait([this] { afterPostStep(); });
         }
@@ -709,6 +827,25 @@ namespace MWPhysics
         mPostSimBarrier->wait([this] { afterPostSim(); });
     }
 
+    void PhysicsTaskScheduler::runReplay()
+    {
+        Log(Debug::Info) << "Replaying physics simulation...";
+        MaybeSharedLock lock(mCollisionWorldMutex, mNumThreads);
+        const std::vector<PhysicsReplay::Result> results
+            = mReplay->replay(*mCollisionWorld, Config::computeReplayThreadsCounts());
+        for (const PhysicsReplay::Result& result : results)
+        {
+            const double meanStepTime = result.mSteps == 0 ? 0 : result.mTotalTime / result.mSteps;
+            Log(Debug::Info) << "Physics replay with " << result.mThreads << " thread(s): " << result.mFrames
+                             << " frames, " << result.mSteps << " steps, " << result.mActorSteps << " actor steps, "
+                             << "total " << result.mTotalTime * 1000 << " ms, mean step " << meanStepTime * 1000
+                             << " ms, max step " << result.mMaxStepTime * 1000 << " ms";
+            if (!result.mDeterministic)
+                Log(Debug::Error) << "Physics replay with " << result.mThreads
+                                  << " thread(s) is not deterministic: actors states differ from the first replay";
+        }
+    }
+
     void PhysicsTaskScheduler::updateStats(osg::Timer_t frameStart, unsigned int frameNumber, osg::Stats& stats)
     {
         if (!stats.collectStats("engine"))
@@ -738,6 +875,25 @@ namespace MWPhysics
         return (*it)->getUserPointer();
     }
 
+    bool PhysicsTaskScheduler::isStaticSupport(const btCollisionObject* object) const
+    {
+        auto it = mCollisionObjects.find(object);
+        if (it == mCollisionObjects.end())
+            return false;
+        switch ((*it)->getBroadphaseHandle()->m_collisionFilterGroup)
+        {
+            case CollisionType_HeightMap:
+                return true;
+            case CollisionType_World:
+            {
+                const auto* worldObject = static_cast<const Object*>((*it)->getUserPointer());
+                return worldObject != nullptr && !worldObject->isAnimated();
+            }
+            default:
+                return false;
+        }
+    }
+
     void PhysicsTaskScheduler::releaseSharedStates()
     {
         waitForWorkers();
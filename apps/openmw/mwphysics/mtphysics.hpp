@@ -3,6 +3,7 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <functional>
 #include <optional>
 #include <shared_mutex>
 #include <thread>
@@ -13,6 +14,7 @@
 #include <osg/Timer>
 
 #include "components/misc/budgetmeasurement.hpp"
+#include "components/misc/workerpool.hpp"
 #include "physicssystem.hpp"
 #include "ptrholder.hpp"
 
@@ -28,6 +30,8 @@ namespace MWRender
 
 namespace MWPhysics
 {
+    class PhysicsReplay;
+
     class PhysicsTaskScheduler
     {
     public:
@@ -50,9 +54,15 @@ namespace MWPhysics
         void convexSweepTest(const btConvexShape* castShape, const btTransform& from, const btTransform& to,
             btCollisionWorld::ConvexResultCallback& resultCallback) const;
         void contactTest(btCollisionObject* colObj, btCollisionWorld::ContactResultCallback& resultCallback);
+        /// @brief calls test(world, i) for each i in [0, count) locking the collision world once for all calls
+        /// @note calls may run concurrently in the query threads, so test must only read the collision world
+        void batchTest(
+            std::size_t count, const std::function<void(const btCollisionWorld&, std::size_t)>& test) const;
         std::optional<btVector3> getHitPoint(const btTransform& from, btCollisionObject* target);
         void aabbTest(const btVector3& aabbMin, const btVector3& aabbMax, btBroadphaseAabbCallback& callback);
         void getAabb(const btCollisionObject* obj, btVector3& min, btVector3& max);
+        /// @brief computes the aabb of the object shape placed with the given transform
+        void getAabb(const btCollisionObject* obj, const btTransform& transform, btVector3& min, btVector3& max);
         void setCollisionFilterMask(btCollisionObject* collisionObject, int collisionFilterMask);
         void addCollisionObject(btCollisionObject* collisionObject, int collisionFilterGroup, int collisionFilterMask);
         void removeCollisionObject(btCollisionObject* collisionObject);
@@ -60,6 +70,8 @@ namespace MWPhysics
         bool getLineOfSight(const std::shared_ptr<Actor>& actor1, const std::shared_ptr<Actor>& actor2);
         void debugDraw();
         void* getUserPointer(const btCollisionObject* object) const;
+        /// @return true if the object can't move by itself, so an idle actor standing on it may sleep
+        bool isStaticSupport(const btCollisionObject* object) const;
         void releaseSharedStates(); // destroy all objects whose destructor can't be safely called from
                                     // ~PhysicsTaskScheduler()
 
@@ -78,8 +90,10 @@ namespace MWPhysics
         void afterPostSim();
         void syncWithMainThread();
         void waitForWorkers();
+        void runReplay();
 
         std::unique_ptr<WorldFrameData> mWorldFrameData;
+        std::unique_ptr<PhysicsReplay> mReplay;
         std::vector<Simulation>* mSimulations = nullptr;
         std::unordered_set<const btCollisionObject*> mCollisionObjects;
         float mDefaultPhysicsDt;
@@ -97,6 +111,7 @@ namespace MWPhysics
 
         unsigned mNumThreads;
         int mNumJobs;
+        int mProjectilesBegin;
         int mRemainingSteps;
         int mLOSCacheExpiry;
         std::size_t mFrameCounter;
@@ -114,6 +129,8 @@ namespace MWPhysics
         mutable std::shared_mutex mCollisionWorldMutex;
         mutable std::shared_mutex mLOSCacheMutex;
         mutable std::mutex mUpdateAabbMutex;
+        mutable std::mutex mQueryThreadsMutex;
+        mutable Misc::WorkerPool mQueryThreads;
         std::condition_variable_any mHasJob;
 
         unsigned int mFrameNumber;
@@ -0,0 +1,180 @@
+#include "physicsreplay.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <unordered_map>
+#include <variant>
+
+#include <BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
+#include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
+#include <BulletCollision/CollisionDispatch/btDefaultCollisionConfiguration.h>
+
+#include <components/misc/convert.hpp>
+#include <components/misc/workerpool.hpp>
+
+#include "actor.hpp"
+#include "collisiontype.hpp"
+#include "movementsolver.hpp"
+
+namespace MWPhysics
+{
+    namespace
+    {
+        // Collision world with its own collision objects sharing shapes with the engine ones
+        struct ReplayWorld
+        {
+            btDefaultCollisionConfiguration mConfiguration;
+            btCollisionDispatcher mDispatcher{ &mConfiguration };
+            btDbvtBroadphase mBroadphase;
+            std::vector<std::unique_ptr<btCollisionObject>> mObjects;
+            std::unordered_map<const btCollisionObject*, btCollisionObject*> mCopies;
+            btCollisionWorld mWorld{ &mDispatcher, &mBroadphase, &mConfiguration };
+
+            explicit ReplayWorld(const btCollisionWorld& source)
+            {
+                mWorld.setForceUpdateAllAabbs(false);
+                const btCollisionObjectArray& objects = source.getCollisionObjectArray();
+                mObjects.reserve(objects.size());
+                for (int i = 0; i < objects.size(); ++i)
+                {
+                    const btCollisionObject* object = objects[i];
+                    const btBroadphaseProxy* proxy = object->getBroadphaseHandle();
+                    // Projectiles report hits to the engine, they are not a part of the replay
+                    if (proxy->m_collisionFilterGroup == CollisionType_Projectile)
+                        continue;
+                    auto copy = std::make_unique<btCollisionObject>();
+                    copy->setCollisionShape(const_cast<btCollisionShape*>(object->getCollisionShape()));
+                    copy->setCollisionFlags(object->getCollisionFlags());
+                    copy->setWorldTransform(object->getWorldTransform());
+                    mWorld.addCollisionObject(
+                        copy.get(), proxy->m_collisionFilterGroup, proxy->m_collisionFilterMask);
+                    mCopies.emplace(object, copy.get());
+                    mObjects.push_back(std::move(copy));
+                }
+            }
+        };
+
+        struct ReplayedActors
+        {
+            std::vector<ActorFrameData> mData;
+            std::vector<btVector3> mOffsets;
+        };
+
+        struct ActorState
+        {
+            osg::Vec3f mPosition;
+            bool mIsOnGround;
+
+            friend bool operator==(const ActorState& l, const ActorState& r)
+            {
+                return l.mPosition == r.mPosition && l.mIsOnGround == r.mIsOnGround;
+            }
+        };
+    }
+
+    PhysicsReplay::PhysicsReplay(std::size_t framesCount)
+        : mFramesCount(framesCount)
+    {
+        mFrames.reserve(framesCount);
+    }
+
+    void PhysicsReplay::record(
+        std::vector<Simulation>& simulations, int numSteps, float physicsDt, const WorldFrameData& worldData)
+    {
+        if (isComplete() || numSteps == 0)
+            return;
+        Frame& frame = mFrames.emplace_back(Frame{ numSteps, physicsDt, worldData, {} });
+        for (Simulation& sim : simulations)
+        {
+            auto* actorSim = std::get_if<ActorSimulation>(&sim);
+            if (actorSim == nullptr)
+                continue;
+            auto locked = actorSim->lock();
+            if (!locked.has_value())
+                continue;
+            auto& [actor, data] = *locked;
+            frame.mActors.push_back(
+                RecordedActor{ actor, data.get(), actor->getCollisionObject()->getWorldTransform() });
+        }
+    }
+
+    std::vector<PhysicsReplay::Result> PhysicsReplay::replay(
+        const btCollisionWorld& collisionWorld, const std::vector<unsigned>& threadsCounts)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        ReplayWorld world(collisionWorld);
+        ReplayedActors actors;
+        std::vector<ActorState> expected;
+        std::vector<ActorState> states;
+        std::vector<Result> results;
+
+        for (const unsigned threads : threadsCounts)
+        {
+            Misc::WorkerPool pool(std::max(threads, 1u) - 1);
+            Result& result = results.emplace_back();
+            result.mThreads = threads;
+            states.clear();
+
+            for (const Frame& frame : mFrames)
+            {
+                actors.mData.clear();
+                actors.mOffsets.clear();
+                for (const RecordedActor& recorded : frame.mActors)
+                {
+                    // Actor could be removed and its collision object address reused by another object
+                    const std::shared_ptr<Actor> actor = recorded.mActor.lock();
+                    if (actor == nullptr || actor->getCollisionObject() != recorded.mData.mCollisionObject)
+                        continue;
+                    const auto copy = world.mCopies.find(recorded.mData.mCollisionObject);
+                    if (copy == world.mCopies.end())
+                        continue;
+                    ActorFrameData& data = actors.mData.emplace_back(recorded.mData);
+                    data.mCollisionObject = copy->second;
+                    copy->second->setWorldTransform(recorded.mTransform);
+                    world.mWorld.updateSingleAabb(copy->second);
+                    actors.mOffsets.push_back(
+                        recorded.mTransform.getOrigin() - Misc::Convert::toBullet(recorded.mData.mPosition));
+                }
+
+                for (int step = 0; step < frame.mSteps; ++step)
+                {
+                    const Clock::time_point start = Clock::now();
+
+                    // Unstuck moves collision object of the actor so it can't be done concurrently
+                    for (ActorFrameData& data : actors.mData)
+                        MovementSolver::unstuck(data, &world.mWorld);
+
+                    pool.forEach(actors.mData.size(), [&](std::size_t i) {
+                        MovementSolver::move(actors.mData[i], frame.mPhysicsDt, &world.mWorld, frame.mWorldData);
+                    });
+
+                    for (std::size_t i = 0; i < actors.mData.size(); ++i)
+                    {
+                        btCollisionObject* object = actors.mData[i].mCollisionObject;
+                        object->getWorldTransform().setOrigin(
+                            Misc::Convert::toBullet(actors.mData[i].mPosition) + actors.mOffsets[i]);
+                        world.mWorld.updateSingleAabb(object);
+                    }
+
+                    const double time = std::chrono::duration<double>(Clock::now() - start).count();
+                    result.mTotalTime += time;
+                    result.mMaxStepTime = std::max(result.mMaxStepTime, time);
+                    ++result.mSteps;
+                    result.mActorSteps += actors.mData.size();
+                }
+
+                for (const ActorFrameData& data : actors.mData)
+                    states.push_back(ActorState{ data.mPosition, data.mIsOnGround });
+                ++result.mFrames;
+            }
+
+            if (results.size() == 1)
+                expected.swap(states);
+            else
+                result.mDeterministic = states == expected;
+        }
+
+        return results;
+    }
+}
@@ -0,0 +1,69 @@
+#ifndef OPENMW_MWPHYSICS_PHYSICSREPLAY_H
+#define OPENMW_MWPHYSICS_PHYSICSREPLAY_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <LinearMath/btTransform.h>
+
+#include "physicssystem.hpp"
+
+class btCollisionWorld;
+
+namespace MWPhysics
+{
+    class Actor;
+
+    // Captures actors simulation inputs for a number of frames and replays them against the movement solver in a
+    // private copy of the collision world. The same frames are replayed with different threads count, results are
+    // expected to be the same for all of them. This allows to measure the solver performance and to check it is
+    // deterministic without the rest of the engine.
+    class PhysicsReplay
+    {
+    public:
+        struct Result
+        {
+            unsigned mThreads = 0;
+            std::size_t mFrames = 0;
+            std::size_t mSteps = 0;
+            std::size_t mActorSteps = 0;
+            double mTotalTime = 0; // seconds
+            double mMaxStepTime = 0; // seconds
+            bool mDeterministic = true;
+        };
+
+        explicit PhysicsReplay(std::size_t framesCount);
+
+        bool isComplete() const { return mFrames.size() >= mFramesCount; }
+
+        // Must be called after simulations are initialized for the frame and before they are simulated.
+        void record(
+            std::vector<Simulation>& simulations, int numSteps, float physicsDt, const WorldFrameData& worldData);
+
+        // Replays recorded frames once for every threads count using a copy of the given collision world. The world
+        // must not be modified during the call. Actors removed since recording are skipped.
+        std::vector<Result> replay(const btCollisionWorld& collisionWorld, const std::vector<unsigned>& threadsCounts);
+
+    private:
+        struct RecordedActor
+        {
+            std::weak_ptr<Actor> mActor;
+            ActorFrameData mData;
+            btTransform mTransform;
+        };
+
+        struct Frame
+        {
+            int mSteps;
+            float mPhysicsDt;
+            WorldFrameData mWorldData;
+            std::vector<RecordedActor> mActors;
+        };
+
+        std::size_t mFramesCount;
+        std::vector<Frame> mFrames;
+    };
+}
+
+#endif
@@ -57,6 +57,21 @@
 
 namespace
 {
+    MWPhysics::RayCastingResult makeRayCastingResult(bool hasHit, const btVector3& hitPoint,
+        const btVector3& hitNormal, const btCollisionObject* hitObject)
+    {
+        MWPhysics::RayCastingResult result;
+        result.mHit = hasHit;
+        if (hasHit)
+        {
+            result.mHitPos = Misc::Convert::toOsg(hitPoint);
+            result.mHitNormal = Misc::Convert::toOsg(hitNormal);
+            if (auto* ptrHolder = static_cast<MWPhysics::PtrHolder*>(hitObject->getUserPointer()))
+                result.mHitObject = ptrHolder->getPtr();
+        }
+        return result;
+    }
+
     void handleJump(const MWWorld::Ptr& ptr)
     {
         if (!ptr.getClass().isActor())
@@ -87,6 +102,20 @@ namespace
         ptr.getClass().getMovementSettings(ptr).mPosition[2] = 0;
     }
 
+    class WakeUpActorsCallback final : public btBroadphaseAabbCallback
+    {
+    public:
+        bool process(const btBroadphaseProxy* proxy) override
+        {
+            if ((proxy->m_collisionFilterGroup & MWPhysics::CollisionType_Actor) == 0)
+                return true;
+            const auto collisionObject = static_cast<btCollisionObject*>(proxy->m_clientObject);
+            if (auto* actor = static_cast<MWPhysics::Actor*>(collisionObject->getUserPointer()))
+                actor->wakeUp();
+            return true;
+        }
+    };
+
 }
 
 namespace MWPhysics
@@ -291,22 +320,9 @@ namespace MWPhysics
         btVector3 btFrom = Misc::Convert::toBullet(from);
         btVector3 btTo = Misc::Convert::toBullet(to);
 
-        const btCollisionObject* me = nullptr;
+        const btCollisionObject* me = getCollisionObject(ignore);
         std::vector<const btCollisionObject*> targetCollisionObjects;
 
-        if (!ignore.isEmpty())
-        {
-            const Actor* actor = getActor(ignore);
-            if (actor)
-                me = actor->getCollisionObject();
-            else
-            {
-                const Object* object = getObject(ignore);
-                if (object)
-                    me = object->getCollisionObject();
-            }
-        }
-
         if (!targets.empty())
         {
             for (const MWWorld::Ptr& target : targets)
@@ -323,16 +339,8 @@ namespace MWPhysics
 
         mTaskScheduler->rayTest(btFrom, btTo, resultCallback);
 
-        RayCastingResult result;
-        result.mHit = resultCallback.hasHit();
-        if (resultCallback.hasHit())
-        {
-            result.mHitPos = Misc::Convert::toOsg(resultCallback.m_hitPointWorld);
-            result.mHitNormal = Misc::Convert::toOsg(resultCallback.m_hitNormalWorld);
-            if (PtrHolder* ptrHolder = static_cast<PtrHolder*>(resultCallback.m_collisionObject->getUserPointer()))
-                result.mHitObject = ptrHolder->getPtr();
-        }
-        return result;
+        return makeRayCastingResult(resultCallback.hasHit(), resultCallback.m_hitPointWorld,
+            resultCallback.m_hitNormalWorld, resultCallback.m_collisionObject);
     }
 
     RayCastingResult PhysicsSystem::castSphere(
@@ -351,16 +359,74 @@ namespace MWPhysics
 
         mTaskScheduler->convexSweepTest(&shape, from_, to_, callback);
 
-        RayCastingResult result;
-        result.mHit = callback.hasHit();
-        if (result.mHit)
+        return makeRayCastingResult(
+            callback.hasHit(), callback.m_hitPointWorld, callback.m_hitNormalWorld, callback.m_hitCollisionObject);
+    }
+
+    void PhysicsSystem::castRays(
+        const std::vector<RayCastingRequest>& requests, std::vector<RayCastingResult>& results) const
+    {
+        struct Hit
         {
-            result.mHitPos = Misc::Convert::toOsg(callback.m_hitPointWorld);
-            result.mHitNormal = Misc::Convert::toOsg(callback.m_hitNormalWorld);
-            if (auto* ptrHolder = static_cast<PtrHolder*>(callback.m_hitCollisionObject->getUserPointer()))
-                result.mHitObject = ptrHolder->getPtr();
-        }
-        return result;
+            bool mHasHit = false;
+            btVector3 mPoint;
+            btVector3 mNormal;
+            const btCollisionObject* mObject = nullptr;
+        };
+
+        // Objects lookup and conversion of the results are done here, workers only query the collision world.
+        std::vector<const btCollisionObject*> ignored(requests.size(), nullptr);
+        for (std::size_t i = 0; i < requests.size(); ++i)
+            if (requests[i].mRadius <= 0)
+                ignored[i] = getCollisionObject(requests[i].mIgnore);
+
+        std::vector<Hit> hits(requests.size());
+
+        mTaskScheduler->batchTest(requests.size(), [&](const btCollisionWorld& collisionWorld, std::size_t i) {
+            const RayCastingRequest& request = requests[i];
+            if (request.mFrom == request.mTo)
+                return;
+            const btVector3 from = Misc::Convert::toBullet(request.mFrom);
+            const btVector3 to = Misc::Convert::toBullet(request.mTo);
+            Hit& hit = hits[i];
+            if (request.mRadius <= 0)
+            {
+                ClosestNotMeRayResultCallback callback(ignored[i], {}, from, to);
+                callback.m_collisionFilterGroup = request.mGroup;
+                callback.m_collisionFilterMask = request.mMask;
+                collisionWorld.rayTest(from, to, callback);
+                hit = Hit{ callback.hasHit(), callback.m_hitPointWorld, callback.m_hitNormalWorld,
+                    callback.m_collisionObject };
+            }
+            else
+            {
+                btCollisionWorld::ClosestConvexResultCallback callback(from, to);
+                callback.m_collisionFilterGroup = request.mGroup;
+                callback.m_collisionFilterMask = request.mMask;
+                const btSphereShape shape(request.mRadius);
+                const btQuaternion rotation = btQuaternion::getIdentity();
+                collisionWorld.convexSweepTest(
+                    &shape, btTransform(rotation, from), btTransform(rotation, to), callback);
+                hit = Hit{ callback.hasHit(), callback.m_hitPointWorld, callback.m_hitNormalWorld,
+                    callback.m_hitCollisionObject };
+            }
+        });
+
+        results.clear();
+        results.reserve(hits.size());
+        for (const Hit& hit : hits)
+            results.push_back(makeRayCastingResult(hit.mHasHit, hit.mPoint, hit.mNormal, hit.mObject));
+    }
+
+    const btCollisionObject* PhysicsSystem::getCollisionObject(const MWWorld::ConstPtr& ptr) const
+    {
+        if (ptr.isEmpty())
+            return nullptr;
+        if (const Actor* actor = getActor(ptr))
+            return actor->getCollisionObject();
+        if (const Object* object = getObject(ptr))
+            return object->getCollisionObject();
+        return nullptr;
     }
 
     bool PhysicsSystem::getLineOfSight(const MWWorld::ConstPtr& actor1, const MWWorld::ConstPtr& actor2) const
@@ -471,15 +537,47 @@ namespace MWPhysics
     void PhysicsSystem::addHeightField(
         const float* heights, int x, int y, int size, int verts, float minH, float maxH, const osg::Object* holdObject)
     {
+        const bool flat = minH == maxH;
+        std::shared_ptr<const HeightFieldShape> shape;
+        // Data without holding object may be reused for different heights, so only flat heightfields are safe to
+        // share then
+        if (flat || holdObject != nullptr)
+        {
+            const HeightFieldShapeKey key = flat ? HeightFieldShapeKey(nullptr, nullptr, size, verts, minH, maxH)
+                                                 : HeightFieldShapeKey(heights, holdObject, size, verts, minH, maxH);
+            std::weak_ptr<const HeightFieldShape>& cached = mHeightFieldShapes[key];
+            shape = cached.lock();
+            if (shape == nullptr)
+            {
+                shape = std::make_shared<HeightFieldShape>(heights, size, verts, minH, maxH, holdObject);
+                cached = shape;
+            }
+        }
+        else
+            shape = std::make_shared<HeightFieldShape>(heights, size, verts, minH, maxH, holdObject);
+
         mHeightFields[std::make_pair(x, y)]
-            = std::make_unique<HeightField>(heights, x, y, size, verts, minH, maxH, holdObject, mTaskScheduler.get());
+            = std::make_unique<HeightField>(std::move(shape), x, y, size, minH, maxH, mTaskScheduler.get());
+        for (const auto& [_, actor] : mActors)
+            actor->wakeUp();
     }
 
     void PhysicsSystem::removeHeightField(int x, int y)
     {
         HeightFieldMap::iterator heightfield = mHeightFields.find(std::make_pair(x, y));
         if (heightfield != mHeightFields.end())
+        {
             mHeightFields.erase(heightfield);
+            for (auto it = mHeightFieldShapes.begin(); it != mHeightFieldShapes.end();)
+            {
+                if (it->second.expired())
+                    it = mHeightFieldShapes.erase(it);
+                else
+                    ++it;
+            }
+            for (const auto& [_, actor] : mActors)
+                actor->wakeUp();
+        }
     }
 
     const HeightField* PhysicsSystem::getHeightField(int x, int y) const
@@ -516,6 +614,7 @@ namespace MWPhysics
 
         auto obj = std::make_shared<Object>(ptr, shapeInstance, rotation, collisionType, mTaskScheduler.get());
         mObjects.emplace(ptr.mRef, obj);
+        wakeUpActorsNear(*obj);
 
         if (obj->isAnimated())
             mAnimatedObjects.emplace(obj.get(), false);
@@ -526,6 +625,7 @@ namespace MWPhysics
         if (auto foundObject = mObjects.find(ptr.mRef); foundObject != mObjects.end())
         {
             mAnimatedObjects.erase(foundObject->second.get());
+            wakeUpActorsNear(*foundObject->second);
 
             mObjects.erase(foundObject);
         }
@@ -599,6 +699,7 @@ namespace MWPhysics
         if (auto foundObject = mObjects.find(ptr.mRef); foundObject != mObjects.end())
         {
             float scale = ptr.getCellRef().getScale();
+            wakeUpActorsNear(*foundObject->second);
             foundObject->second->setScale(scale);
             mTaskScheduler->updateSingleAabb(foundObject->second);
         }
@@ -613,7 +714,9 @@ namespace MWPhysics
     {
         if (auto foundObject = mObjects.find(ptr.mRef); foundObject != mObjects.end())
         {
+            wakeUpActorsNear(*foundObject->second);
             foundObject->second->setRotation(rotate);
+            wakeUpActorsNear(*foundObject->second);
             mTaskScheduler->updateSingleAabb(foundObject->second);
         }
         else if (auto foundActor = mActors.find(ptr.mRef); foundActor != mActors.end())
@@ -630,7 +733,9 @@ namespace MWPhysics
     {
         if (auto foundObject = mObjects.find(ptr.mRef); foundObject != mObjects.end())
         {
+            wakeUpActorsNear(*foundObject->second);
             foundObject->second->updatePosition();
+            wakeUpActorsNear(*foundObject->second);
             mTaskScheduler->updateSingleAabb(foundObject->second);
         }
         else if (auto foundActor = mActors.find(ptr.mRef); foundActor != mActors.end())
@@ -739,6 +844,13 @@ namespace MWPhysics
             if (cell->getCell()->hasWater())
                 waterlevel = cell->getWaterLevel();
 
+            if (physicActor->isSleeping())
+            {
+                if (!physicActor->hasVelocity() && physicActor->getSleepingWaterLevel() == waterlevel)
+                    continue;
+                physicActor->wakeUp();
+            }
+
             const auto& stats = ptr.getClass().getCreatureStats(ptr);
             const MWMechanics::MagicEffects& effects = stats.getMagicEffects();
 
@@ -767,6 +879,7 @@ namespace MWPhysics
                 handleJump(ptr);
         }
 
+        // Projectiles must go after actors, the scheduler moves them in batches
         for (const auto& [id, projectile] : mProjectiles)
         {
             simulations.emplace_back(ProjectileSimulation{ projectile, ProjectileFrameData{ *projectile } });
@@ -783,6 +896,7 @@ namespace MWPhysics
                 auto obj = mObjects.find(animatedObject->getPtr().mRef);
                 assert(obj != mObjects.end());
                 mTaskScheduler->updateSingleAabb(obj->second);
+                wakeUpActorsNear(*obj->second);
                 changed = true;
             }
             else
@@ -820,7 +934,8 @@ namespace MWPhysics
         mActorsPositions.reserve(mActors.size() - 1);
         for (const auto& [ptr, physicActor] : mActors)
         {
-            if (physicActor.get() == player)
+            // sleeping actors keep their position
+            if (physicActor.get() == player || physicActor->isSleeping())
                 continue;
             mActorsPositions.emplace_back(physicActor->getPtr(), physicActor->getSimulationPosition());
         }
@@ -959,11 +1074,24 @@ namespace MWPhysics
     void PhysicsSystem::reportStats(unsigned int frameNumber, osg::Stats& stats) const
     {
         stats.setAttribute(frameNumber, "Physics Actors", mActors.size());
+        stats.setAttribute(frameNumber, "Physics Actors Sleeping",
+            std::count_if(mActors.begin(), mActors.end(), [](const auto& v) { return v.second->isSleeping(); }));
         stats.setAttribute(frameNumber, "Physics Objects", mObjects.size());
         stats.setAttribute(frameNumber, "Physics Projectiles", mProjectiles.size());
         stats.setAttribute(frameNumber, "Physics HeightFields", mHeightFields.size());
     }
 
+    void PhysicsSystem::wakeUpActorsNear(const Object& object)
+    {
+        // Actors rest a bit above the ground, so extend the box to catch the ones standing on the object
+        const btVector3 margin(1, 1, 1);
+        btVector3 aabbMin;
+        btVector3 aabbMax;
+        mTaskScheduler->getAabb(object.getCollisionObject(), object.getTransform(), aabbMin, aabbMax);
+        WakeUpActorsCallback callback;
+        mTaskScheduler->aabbTest(aabbMin - margin, aabbMax + margin, callback);
+    }
+
     void PhysicsSystem::reportCollision(const btVector3& position, const btVector3& normal)
     {
         if (mDebugDrawEnabled)
@@ -8,6 +8,7 @@
 #include <optional>
 #include <set>
 #include <span>
+#include <tuple>
 #include <unordered_map>
 #include <variant>
 
@@ -52,6 +53,7 @@ class btVector3;
 namespace MWPhysics
 {
     class HeightField;
+    class HeightFieldShape;
     class Object;
     class Actor;
     class PhysicsTaskScheduler;
@@ -175,6 +177,9 @@ namespace MWPhysics
 
         const Object* getObject(const MWWorld::ConstPtr& ptr) const;
 
+        /// Returns nullptr if ptr is empty or has no collision object.
+        const btCollisionObject* getCollisionObject(const MWWorld::ConstPtr& ptr) const;
+
         Projectile* getProjectile(int projectileId) const;
 
         // Object or Actor
@@ -227,6 +232,9 @@ namespace MWPhysics
         RayCastingResult castSphere(const osg::Vec3f& from, const osg::Vec3f& to, float radius,
             int mask = CollisionType_Default, int group = 0xff) const override;
 
+        void castRays(
+            const std::vector<RayCastingRequest>& requests, std::vector<RayCastingResult>& results) const override;
+
         /// Return true if actor1 can see actor2.
         bool getLineOfSight(const MWWorld::ConstPtr& actor1, const MWWorld::ConstPtr& actor2) const override;
 
@@ -301,6 +309,9 @@ namespace MWPhysics
 
         void prepareSimulation(bool willSimulate, std::vector<Simulation>& simulations);
 
+        /// Wakes up sleeping actors touching or standing on the object at its current transform
+        void wakeUpActorsNear(const Object& object);
+
         std::unique_ptr<btBroadphaseInterface> mBroadphase;
         std::unique_ptr<btDefaultCollisionConfiguration> mCollisionConfiguration;
         std::unique_ptr<btCollisionDispatcher> mDispatcher;
@@ -323,6 +334,11 @@ namespace MWPhysics
         using HeightFieldMap = std::map<std::pair<int, int>, std::unique_ptr<HeightField>>;
         HeightFieldMap mHeightFields;
 
+        // Heightfields with the same data share the shape. Flat heightfields are identified by the height, others by
+        // the data pointer and the object holding it.
+        using HeightFieldShapeKey = std::tuple<const float*, const osg::Object*, int, int, float, float>;
+        std::map<HeightFieldShapeKey, std::weak_ptr<const HeightFieldShape>> mHeightFieldShapes;
+
         bool mDebugDrawEnabled;
 
         float mTimeAccum;
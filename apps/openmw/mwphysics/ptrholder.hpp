@@ -36,6 +36,8 @@ namespace MWPhysics
 
         osg::Vec3f velocity() { return std::exchange(mVelocity, osg::Vec3f()); }
 
+        bool hasVelocity() const { return mVelocity != osg::Vec3f(); }
+
         void setSimulationPosition(const osg::Vec3f& position) { mSimulationPosition = position; }
 
         osg::Vec3f getSimulationPosition() const { return mSimulationPosition; }
@@ -3,6 +3,8 @@
 
 #include <osg/Vec3f>
 
+#include <vector>
+
 #include "../mwworld/ptr.hpp"
 
 #include "collisiontype.hpp"
@@ -18,6 +20,18 @@ namespace MWPhysics
         MWWorld::Ptr mHitObject;
     };
 
+    struct RayCastingRequest
+    {
+        osg::Vec3f mFrom;
+        osg::Vec3f mTo;
+        /// Casts a sphere of this radius if positive, a ray otherwise.
+        float mRadius = 0;
+        /// Object to ignore, used only for rays.
+        MWWorld::ConstPtr mIgnore;
+        int mMask = CollisionType_Default;
+        int mGroup = 0xff;
+    };
+
     class RayCastingInterface
     {
     public:
@@ -42,6 +56,11 @@ namespace MWPhysics
         virtual RayCastingResult castSphere(const osg::Vec3f& from, const osg::Vec3f& to, float radius,
             int mask = CollisionType_Default, int group = 0xff) const = 0;
 
+        /// Same as castRay and castSphere for each request but with a single lock of the collision world for all
+        /// of them. Requests may be processed concurrently. results[i] corresponds to requests[i].
+        virtual void castRays(
+            const std::vector<RayCastingRequest>& requests, std::vector<RayCastingResult>& results) const = 0;
+
         /// Return true if actor1 can see actor2.
         virtual bool getLineOfSight(const MWWorld::ConstPtr& actor1, const MWWorld::ConstPtr& actor2) const = 0;
     };
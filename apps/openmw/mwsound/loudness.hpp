@@ -2,12 +2,14 @@
 #define GAME_SOUND_LOUDNESS_H
 
 #include <deque>
+#include <utility>
 #include <vector>
 
 #include "sound_decoder.hpp"
 
 namespace MWSound
 {
+    const int sLoudnessFPS = 20; // loudness values per second of audio
 
     class Sound_Loudness
     {
@@ -36,6 +38,19 @@ namespace MWSound
         {
         }
 
+        /**
+         * @param samplesPerSecond How many loudness values per second of audio are in \a samples.
+         * @param samples previously computed loudness values
+         */
+        Sound_Loudness(float samplesPerSecond, std::vector<float> samples)
+            : mSamplesPerSec(samplesPerSecond)
+            , mSampleRate(0)
+            , mChannelConfig(ChannelConfig_Mono)
+            , mSampleType(SampleType_UInt8)
+            , mSamples(std::move(samples))
+        {
+        }
+
         /**
          * Analyzes the energy (closely related to loudness) of a sound buffer.
          * The buffer will be divided into segments according to \a valuesPerSecond,
@@ -53,6 +68,10 @@ namespace MWSound
          * time (see analyzeLoudness()).
          */
         float getLoudnessAtTime(float sec) const;
+
+        float getSamplesPerSecond() const { return mSamplesPerSec; }
+
+        const std::vector<float>& getSamples() const { return mSamples; }
     };
 
 }
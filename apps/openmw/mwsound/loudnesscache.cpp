@@ -0,0 +1,266 @@
+#include "loudnesscache.hpp"
+
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include <components/debug/debuglog.hpp>
+#include <components/files/conversion.hpp>
+#include <components/files/hash.hpp>
+#include <components/vfs/manager.hpp>
+
+#include "loudness.hpp"
+
+namespace MWSound
+{
+    namespace
+    {
+        constexpr std::array<char, 4> sMagic{ 'O', 'M', 'W', 'L' };
+        constexpr std::uint32_t sVersion = 1;
+        // Loudness of an hour long sound
+        constexpr std::uint32_t sMaxSamples = sLoudnessFPS * 60 * 60;
+        constexpr std::uint32_t sMaxFileNameSize = 4096;
+
+        template <class T>
+        void writeValue(std::ostream& stream, const T& value)
+        {
+            stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        template <class T>
+        T readValue(std::istream& stream)
+        {
+            T value;
+            stream.read(reinterpret_cast<char*>(&value), sizeof(value));
+            if (!stream)
+                throw std::runtime_error("Unexpected end of file");
+            return value;
+        }
+    }
+
+    LoudnessCache::LoudnessCache(const VFS::Manager& vfs, const std::filesystem::path& path)
+        : mVfs(vfs)
+        , mPath(path)
+        , mValidated(false)
+        , mChanged(false)
+        , mShouldStop(false)
+        , mThread([this] { run(); })
+    {
+    }
+
+    LoudnessCache::~LoudnessCache()
+    {
+        {
+            std::lock_guard lock(mMutex);
+            mShouldStop = true;
+        }
+        mHasJob.notify_all();
+        mThread.join();
+    }
+
+    std::shared_ptr<const Sound_Loudness> LoudnessCache::get(const std::string& fileName)
+    {
+        std::lock_guard lock(mMutex);
+        const auto it = mEntries.find(fileName);
+        if (it == mEntries.end() || !it->second.mValidated)
+            return nullptr;
+        return it->second.mLoudness;
+    }
+
+    void LoudnessCache::add(const std::string& fileName, std::shared_ptr<const Sound_Loudness> loudness)
+    {
+        {
+            std::lock_guard lock(mMutex);
+            const auto it = mEntries.find(fileName);
+            if (it != mEntries.end() && it->second.mValidated)
+                return;
+            if (!mQueued.insert(fileName).second)
+                return;
+            mJobs.push_back(Job{ fileName, std::move(loudness) });
+        }
+        mHasJob.notify_all();
+    }
+
+    void LoudnessCache::wait()
+    {
+        std::unique_lock lock(mMutex);
+        mIdle.wait(lock, [&] { return mValidated && mQueued.empty(); });
+    }
+
+    LoudnessCache::Hash LoudnessCache::getFileHash(const std::string& fileName) const
+    {
+        return Files::getHash(Files::pathFromUnicodeString(fileName), *mVfs.get(fileName));
+    }
+
+    void LoudnessCache::run()
+    {
+        load();
+        validate();
+
+        std::unique_lock lock(mMutex);
+        mValidated = true;
+        mIdle.notify_all();
+        while (true)
+        {
+            mHasJob.wait(lock, [&] { return mShouldStop || !mJobs.empty(); });
+            // Added results are hashed even on stop to not lose them
+            if (mJobs.empty())
+                break;
+
+            Job job = std::move(mJobs.front());
+            mJobs.pop_front();
+            lock.unlock();
+
+            std::optional<Hash> hash;
+            try
+            {
+                hash = getFileHash(job.mFileName);
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Warning) << "Failed to hash " << job.mFileName << ": " << e.what();
+            }
+
+            lock.lock();
+            if (hash.has_value())
+            {
+                mEntries.insert_or_assign(job.mFileName, Entry{ *hash, std::move(job.mLoudness), true });
+                mChanged = true;
+            }
+            mQueued.erase(job.mFileName);
+            if (mQueued.empty())
+                mIdle.notify_all();
+        }
+
+        if (mChanged)
+            save();
+    }
+
+    void LoudnessCache::load()
+    {
+        std::ifstream stream(mPath, std::ios::binary);
+        if (!stream.is_open())
+            return;
+
+        std::unordered_map<std::string, Entry> entries;
+        try
+        {
+            if (readValue<std::array<char, 4>>(stream) != sMagic)
+                throw std::runtime_error("Not a loudness cache file");
+            if (readValue<std::uint32_t>(stream) != sVersion)
+                return;
+            const std::uint32_t count = readValue<std::uint32_t>(stream);
+            for (std::uint32_t i = 0; i < count; ++i)
+            {
+                const std::uint32_t fileNameSize = readValue<std::uint32_t>(stream);
+                if (fileNameSize > sMaxFileNameSize)
+                    throw std::runtime_error("Invalid file name size: " + std::to_string(fileNameSize));
+                std::string fileName(fileNameSize, '\0');
+                stream.read(fileName.data(), fileNameSize);
+                const Hash hash = readValue<Hash>(stream);
+                const float samplesPerSecond = readValue<float>(stream);
+                const std::uint32_t samplesCount = readValue<std::uint32_t>(stream);
+                if (samplesCount > sMaxSamples)
+                    throw std::runtime_error("Invalid number of samples: " + std::to_string(samplesCount));
+                std::vector<float> samples(samplesCount);
+                stream.read(reinterpret_cast<char*>(samples.data()), samplesCount * sizeof(float));
+                if (!stream)
+                    throw std::runtime_error("Unexpected end of file");
+                auto loudness = std::make_shared<const Sound_Loudness>(samplesPerSecond, std::move(samples));
+                entries.insert_or_assign(std::move(fileName), Entry{ hash, std::move(loudness), false });
+            }
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to load loudness cache from " << Files::pathToUnicodeString(mPath)
+                                << ": " << e.what();
+            return;
+        }
+
+        Log(Debug::Verbose) << "Loaded loudness of " << entries.size() << " sounds from "
+                            << Files::pathToUnicodeString(mPath);
+
+        // Nothing is added yet, so there is nothing to keep
+        std::lock_guard lock(mMutex);
+        mEntries = std::move(entries);
+    }
+
+    void LoudnessCache::validate()
+    {
+        std::vector<std::string> fileNames;
+        {
+            std::lock_guard lock(mMutex);
+            fileNames.reserve(mEntries.size());
+            for (const auto& [fileName, entry] : mEntries)
+                fileNames.push_back(fileName);
+        }
+
+        for (const std::string& fileName : fileNames)
+        {
+            std::optional<Hash> hash;
+            try
+            {
+                hash = getFileHash(fileName);
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Verbose) << "Failed to validate loudness of " << fileName << ": " << e.what();
+            }
+
+            std::lock_guard lock(mMutex);
+            if (mShouldStop)
+                return;
+            const auto it = mEntries.find(fileName);
+            if (it == mEntries.end() || it->second.mValidated)
+                continue;
+            if (hash == it->second.mHash)
+                it->second.mValidated = true;
+            else
+            {
+                // The file is removed or changed, so the entry is not worth keeping
+                mEntries.erase(it);
+                mChanged = true;
+            }
+        }
+    }
+
+    void LoudnessCache::save()
+    {
+        std::filesystem::path tmpPath = mPath;
+        tmpPath += ".tmp";
+
+        try
+        {
+            std::filesystem::create_directories(mPath.parent_path());
+            {
+                std::ofstream stream(tmpPath, std::ios::binary);
+                writeValue(stream, sMagic);
+                writeValue(stream, sVersion);
+                writeValue(stream, static_cast<std::uint32_t>(mEntries.size()));
+                for (const auto& [fileName, entry] : mEntries)
+                {
+                    const std::vector<float>& samples = entry.mLoudness->getSamples();
+                    writeValue(stream, static_cast<std::uint32_t>(fileName.size()));
+                    stream.write(fileName.data(), static_cast<std::streamsize>(fileName.size()));
+                    writeValue(stream, entry.mHash);
+                    writeValue(stream, entry.mLoudness->getSamplesPerSecond());
+                    writeValue(stream, static_cast<std::uint32_t>(samples.size()));
+                    stream.write(reinterpret_cast<const char*>(samples.data()),
+                        static_cast<std::streamsize>(samples.size() * sizeof(float)));
+                }
+                stream.close();
+                if (stream.fail())
+                    throw std::runtime_error("Write operation failed (file stream)");
+            }
+            std::filesystem::rename(tmpPath, mPath);
+        }
+        catch (const std::exception& e)
+        {
+            std::error_code ec;
+            std::filesystem::remove(tmpPath, ec);
+            Log(Debug::Warning) << "Failed to save loudness cache to " << Files::pathToUnicodeString(mPath) << ": "
+                                << e.what();
+        }
+    }
+}
@@ -0,0 +1,90 @@
+#ifndef GAME_SOUND_LOUDNESSCACHE_H
+#define GAME_SOUND_LOUDNESSCACHE_H
+
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace VFS
+{
+    class Manager;
+}
+
+namespace MWSound
+{
+    class Sound_Loudness;
+
+    class LoudnessCache
+    {
+    public:
+        LoudnessCache(const VFS::Manager& vfs, const std::filesystem::path& path);
+        ///< Keeps loudness of sound files to not analyze them every time they are played.
+        ///
+        /// Results are loaded from and stored into the file at \a path. A background thread hashes the sound files
+        /// of all loaded results right after loading, and each of them is used once the hash of its sound file is
+        /// the same. Added results are hashed in the same thread.
+
+        ~LoudnessCache();
+        ///< Hashes added results, stops validation and writes the file if there are new results.
+
+        std::shared_ptr<const Sound_Loudness> get(const std::string& fileName);
+        ///< Get loudness of the sound file if it's analyzed already.
+
+        void add(const std::string& fileName, std::shared_ptr<const Sound_Loudness> loudness);
+        ///< Keep loudness of the sound file analyzed while it was played, once the file is hashed, unless it's
+        /// known or queued already.
+
+        void wait();
+        ///< Wait until the loaded results are validated and the added ones are hashed.
+
+    private:
+        using Hash = std::array<std::uint64_t, 2>;
+
+        struct Entry
+        {
+            Hash mHash;
+            std::shared_ptr<const Sound_Loudness> mLoudness;
+            // Entries loaded from the file may be outdated
+            bool mValidated;
+        };
+
+        struct Job
+        {
+            std::string mFileName;
+            std::shared_ptr<const Sound_Loudness> mLoudness;
+        };
+
+        const VFS::Manager& mVfs;
+        const std::filesystem::path mPath;
+        std::mutex mMutex;
+        std::condition_variable mHasJob;
+        std::condition_variable mIdle;
+        std::deque<Job> mJobs;
+        std::unordered_set<std::string> mQueued;
+        std::unordered_map<std::string, Entry> mEntries;
+        bool mValidated;
+        bool mChanged;
+        bool mShouldStop;
+        std::thread mThread;
+
+        Hash getFileHash(const std::string& fileName) const;
+
+        void run();
+
+        void load();
+
+        void validate();
+
+        void save();
+    };
+}
+
+#endif
@@ -4,7 +4,11 @@
 #include <chrono>
 #include <condition_variable>
 #include <cstring>
+#include <deque>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <thread>
 #include <vector>
 
@@ -13,6 +17,7 @@
 #include <components/debug/debuglog.hpp>
 #include <components/misc/constants.hpp>
 #include <components/misc/resourcehelpers.hpp>
+#include <components/misc/spscqueue.hpp>
 #include <components/vfs/manager.hpp>
 
 #include "loudness.hpp"
@@ -33,7 +38,7 @@
 namespace
 {
 
-    const int sLoudnessFPS = 20; // loudness values per second of audio
+    const unsigned sDecodeThreads = 2;
 
     ALCenum checkALCError(ALCdevice* device, const char* func, int line)
     {
@@ -256,6 +261,87 @@ namespace MWSound
         return AL_NONE;
     }
 
+    //
+    // A sound effect decoded by the decode threads, uploaded to OpenAL by the main thread.
+    //
+    struct DecodedSound
+    {
+        std::string mName;
+        DecoderPtr mDecoder;
+        std::vector<char> mData;
+        int mSampleRate = 0;
+        ChannelConfig mChannels = ChannelConfig_Mono;
+        SampleType mType = SampleType_UInt8;
+        std::atomic<bool> mDone{ false };
+
+        void decode()
+        {
+            try
+            {
+                mDecoder->open(Misc::ResourceHelpers::correctSoundPath(mName, mDecoder->mResourceMgr));
+                mDecoder->getInfo(&mSampleRate, &mChannels, &mType);
+                mDecoder->readAll(mData);
+            }
+            catch (std::exception& e)
+            {
+                Log(Debug::Error) << "Failed to load audio from " << mName << ": " << e.what();
+                mData.clear();
+            }
+            mDecoder.reset();
+            mDone.store(true, std::memory_order_release);
+        }
+    };
+
+    //
+    // Audio of a stream decoded ahead of playback by a decode thread. The decode thread is the only producer and
+    // the stream thread is the only consumer of the chunks, so neither of them waits for the other one.
+    //
+    struct StreamPrefetch
+    {
+        static const std::size_t sMaxChunks = 8;
+
+        DecoderPtr mDecoder;
+        std::size_t mChunkSize = 0;
+        Misc::SpscQueue<std::vector<char>> mChunks{ sMaxChunks };
+        // Set after the last chunk is pushed
+        std::atomic<bool> mEnded{ false };
+        std::atomic<bool> mFailed{ false };
+        std::atomic<bool> mAborted{ false };
+        std::atomic<bool> mScheduled{ false };
+
+        explicit StreamPrefetch(DecoderPtr decoder)
+            : mDecoder(std::move(decoder))
+        {
+        }
+
+        ~StreamPrefetch() { mDecoder->close(); }
+
+        void decode()
+        {
+            while (!mAborted && !mEnded && !mChunks.full())
+            {
+                std::vector<char> data(mChunkSize);
+                std::size_t got = 0;
+                try
+                {
+                    got = mDecoder->read(data.data(), data.size());
+                }
+                catch (std::exception& e)
+                {
+                    Log(Debug::Error) << "Error decoding stream \"" << mDecoder->getName() << "\": " << e.what();
+                    mFailed = true;
+                }
+                if (got > 0)
+                {
+                    data.resize(got);
+                    mChunks.push(std::move(data));
+                }
+                if (got == 0 || got < mChunkSize)
+                    mEnded = true;
+            }
+        }
+    };
+
     //
     // A streaming OpenAL sound.
     //
@@ -275,9 +361,17 @@ namespace MWSound
         ALuint mFrameSize;
         ALint mSilence;
 
-        DecoderPtr mDecoder;
+        // Number of decoded sample frames given to OpenAL
+        std::size_t mQueuedFrames;
 
-        std::unique_ptr<Sound_Loudness> mLoudnessAnalyzer;
+        std::shared_ptr<StreamPrefetch> mPrefetch;
+        // The decoder is used by a decode thread once the stream is playing, so its name is copied before
+        std::string mName;
+
+        std::shared_ptr<Sound_Loudness> mLoudnessAnalyzer;
+        std::shared_ptr<const Sound_Loudness> mLoudness;
+        // Set once all the decoded audio is given to OpenAL
+        bool mDrained;
 
         std::atomic<bool> mIsFinished;
 
@@ -292,7 +386,7 @@ namespace MWSound
         OpenAL_SoundStream(ALuint src, DecoderPtr decoder);
         ~OpenAL_SoundStream();
 
-        bool init(bool getLoudnessData = false);
+        bool init(bool getLoudnessData = false, std::shared_ptr<const Sound_Loudness> loudness = nullptr);
 
         bool isPlaying();
         double getStreamDelay() const;
@@ -300,11 +394,85 @@ namespace MWSound
 
         float getCurrentLoudness() const;
 
+        std::shared_ptr<const Sound_Loudness> getAnalyzedLoudness() const;
+
         bool process();
         ALint refillQueue();
     };
     const ALfloat OpenAL_SoundStream::sBufferLength = 0.125f;
 
+    //
+    // Background threads decoding audio for streams and sound effects
+    //
+    struct DecodeThreads
+    {
+        std::mutex mMutex;
+        std::condition_variable mHasJob;
+        // Streams are already playing, so their jobs are done first
+        std::deque<std::function<void()>> mStreamJobs;
+        std::deque<std::function<void()>> mSoundJobs;
+        bool mQuitNow;
+        std::vector<std::thread> mThreads;
+
+        explicit DecodeThreads(unsigned count)
+            : mQuitNow(false)
+        {
+            for (unsigned i = 0; i < count; ++i)
+                mThreads.emplace_back([this] { run(); });
+        }
+        ~DecodeThreads()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mQuitNow = true;
+            }
+            mHasJob.notify_all();
+            for (std::thread& thread : mThreads)
+                thread.join();
+        }
+
+        void run()
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            while (true)
+            {
+                mHasJob.wait(lock, [&] { return mQuitNow || !mStreamJobs.empty() || !mSoundJobs.empty(); });
+                // Jobs still queued are dropped on purpose. The threads quit only when the output is destroyed,
+                // so no stream or sound buffer waits for them anymore.
+                if (mQuitNow)
+                    return;
+                std::deque<std::function<void()>>& jobs = mStreamJobs.empty() ? mSoundJobs : mStreamJobs;
+                const std::function<void()> job = std::move(jobs.front());
+                jobs.pop_front();
+                lock.unlock();
+                job();
+                lock.lock();
+            }
+        }
+
+        void addStreamJob(std::function<void()>&& job)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mStreamJobs.push_back(std::move(job));
+            }
+            mHasJob.notify_one();
+        }
+
+        void addSoundJob(std::function<void()>&& job)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mSoundJobs.push_back(std::move(job));
+            }
+            mHasJob.notify_one();
+        }
+
+    private:
+        DecodeThreads(const DecodeThreads& rhs);
+        DecodeThreads& operator=(const DecodeThreads& rhs);
+    };
+
     //
     // A background streaming thread (keeps active streams processed)
     //
@@ -316,10 +484,13 @@ namespace MWSound
         std::atomic<bool> mQuitNow;
         std::mutex mMutex;
         std::condition_variable mCondVar;
+        // Decoding is done outside of mMutex, so the main thread is never blocked by it
+        DecodeThreads mDecodeThreads;
         std::thread mThread;
 
         StreamThread()
             : mQuitNow(false)
+            , mDecodeThreads(sDecodeThreads)
             , mThread([this] { run(); })
         {
         }
@@ -344,7 +515,10 @@ namespace MWSound
                     if ((*iter)->process() == false)
                         iter = mStreams.erase(iter);
                     else
+                    {
+                        prefetch((*iter)->mPrefetch);
                         ++iter;
+                    }
                 }
 
                 mCondVar.wait_for(lock, std::chrono::milliseconds(50));
@@ -356,11 +530,24 @@ namespace MWSound
             std::lock_guard<std::mutex> lock(mMutex);
             if (std::find(mStreams.begin(), mStreams.end(), stream) == mStreams.end())
             {
+                prefetch(stream->mPrefetch);
                 mStreams.push_back(stream);
                 mCondVar.notify_all();
             }
         }
 
+        void prefetch(const std::shared_ptr<StreamPrefetch>& prefetch)
+        {
+            if (prefetch->mEnded || prefetch->mChunks.full() || prefetch->mScheduled.exchange(true))
+                return;
+            mDecodeThreads.addStreamJob([this, prefetch] {
+                prefetch->decode();
+                prefetch->mScheduled = false;
+                // Start playback of new streams without waiting for the next pass
+                mCondVar.notify_all();
+            });
+        }
+
         void remove(OpenAL_SoundStream* stream)
         {
             std::lock_guard<std::mutex> lock(mMutex);
@@ -388,8 +575,10 @@ namespace MWSound
         , mBufferSize(0)
         , mFrameSize(0)
         , mSilence(0)
-        , mDecoder(std::move(decoder))
+        , mQueuedFrames(0)
+        , mPrefetch(std::make_shared<StreamPrefetch>(std::move(decoder)))
         , mLoudnessAnalyzer(nullptr)
+        , mDrained(false)
         , mIsFinished(true)
     {
         mBuffers.fill(0);
@@ -401,10 +590,11 @@ namespace MWSound
             alDeleteBuffers(mBuffers.size(), mBuffers.data());
         alGetError();
 
-        mDecoder->close();
+        // The decoder is closed by the decode thread if it is still decoding
+        mPrefetch->mAborted = true;
     }
 
-    bool OpenAL_SoundStream::init(bool getLoudnessData)
+    bool OpenAL_SoundStream::init(bool getLoudnessData, std::shared_ptr<const Sound_Loudness> loudness)
     {
         alGenBuffers(mBuffers.size(), mBuffers.data());
         ALenum err = getALError();
@@ -416,7 +606,8 @@ namespace MWSound
 
         try
         {
-            mDecoder->getInfo(&mSampleRate, &chans, &type);
+            mName = mPrefetch->mDecoder->getName();
+            mPrefetch->mDecoder->getInfo(&mSampleRate, &chans, &type);
             mFormat = getALFormat(chans, type);
         }
         catch (std::exception& e)
@@ -441,9 +632,12 @@ namespace MWSound
         mFrameSize = framesToBytes(1, chans, type);
         mBufferSize = static_cast<ALuint>(sBufferLength * mSampleRate);
         mBufferSize *= mFrameSize;
+        mPrefetch->mChunkSize = mBufferSize;
 
-        if (getLoudnessData)
-            mLoudnessAnalyzer = std::make_unique<Sound_Loudness>(sLoudnessFPS, mSampleRate, chans, type);
+        if (loudness != nullptr)
+            mLoudness = std::move(loudness);
+        else if (getLoudnessData)
+            mLoudnessAnalyzer = std::make_shared<Sound_Loudness>(sLoudnessFPS, mSampleRate, chans, type);
 
         mIsFinished = false;
         return true;
@@ -494,13 +688,13 @@ namespace MWSound
             ALint queued;
             alGetSourcei(mSource, AL_BUFFERS_QUEUED, &queued);
             ALint inqueue = mBufferSize / mFrameSize * queued - offset;
-            t = (double)(mDecoder->getSampleOffset() - inqueue) / (double)mSampleRate;
+            t = (double)((ALint)mQueuedFrames - inqueue) / (double)mSampleRate;
         }
         else
         {
-            /* Underrun, or not started yet. The decoder offset is where we'll play
+            /* Underrun, or not started yet. The queued offset is where we'll play
              * next. */
-            t = (double)mDecoder->getSampleOffset() / (double)mSampleRate;
+            t = (double)mQueuedFrames / (double)mSampleRate;
         }
 
         getALError();
@@ -509,11 +703,19 @@ namespace MWSound
 
     float OpenAL_SoundStream::getCurrentLoudness() const
     {
-        if (!mLoudnessAnalyzer.get())
+        const Sound_Loudness* loudness = mLoudness != nullptr ? mLoudness.get() : mLoudnessAnalyzer.get();
+        if (loudness == nullptr)
             return 0.f;
 
         float time = getStreamOffset();
-        return mLoudnessAnalyzer->getLoudnessAtTime(time);
+        return loudness->getLoudnessAtTime(time);
+    }
+
+    std::shared_ptr<const Sound_Loudness> OpenAL_SoundStream::getAnalyzedLoudness() const
+    {
+        if (!mDrained || mPrefetch->mFailed)
+            return nullptr;
+        return mLoudnessAnalyzer;
     }
 
     bool OpenAL_SoundStream::process()
@@ -535,7 +737,7 @@ namespace MWSound
         }
         catch (std::exception&)
         {
-            Log(Debug::Error) << "Error updating stream \"" << mDecoder->getName() << "\"";
+            Log(Debug::Error) << "Error updating stream \"" << mName << "\"";
             mIsFinished = true;
         }
         return !mIsFinished;
@@ -554,28 +756,39 @@ namespace MWSound
 
         ALint queued;
         alGetSourcei(mSource, AL_BUFFERS_QUEUED, &queued);
-        if (!mIsFinished && (ALuint)queued < mBuffers.size())
+        for (; !mIsFinished && (ALuint)queued < mBuffers.size(); ++queued)
         {
-            std::vector<char> data(mBufferSize);
-            for (; !mIsFinished && (ALuint)queued < mBuffers.size(); ++queued)
+            std::optional<std::vector<char>> data = mPrefetch->mChunks.pop();
+            if (!data)
             {
-                size_t got = mDecoder->read(data.data(), data.size());
-                if (got < data.size())
+                // Underrun, wait for the decode thread unless it already pushed the last chunk
+                if (!mPrefetch->mEnded)
+                    break;
+                data = mPrefetch->mChunks.pop();
+                if (!data)
                 {
+                    mDrained = true;
                     mIsFinished = true;
-                    std::fill(data.begin() + got, data.end(), mSilence);
+                    break;
                 }
-                if (got > 0)
-                {
-                    if (mLoudnessAnalyzer.get())
-                        mLoudnessAnalyzer->analyzeLoudness(data);
+            }
 
-                    ALuint bufid = mBuffers[mCurrentBufIdx];
-                    alBufferData(bufid, mFormat, data.data(), data.size(), mSampleRate);
-                    alSourceQueueBuffers(mSource, 1, &bufid);
-                    mCurrentBufIdx = (mCurrentBufIdx + 1) % mBuffers.size();
-                }
+            const size_t got = data->size();
+            if (got < mBufferSize)
+            {
+                mDrained = true;
+                mIsFinished = true;
+                data->resize(mBufferSize, static_cast<char>(mSilence));
             }
+
+            if (mLoudnessAnalyzer.get())
+                mLoudnessAnalyzer->analyzeLoudness(*data);
+
+            ALuint bufid = mBuffers[mCurrentBufIdx];
+            alBufferData(bufid, mFormat, data->data(), data->size(), mSampleRate);
+            alSourceQueueBuffers(mSource, 1, &bufid);
+            mCurrentBufIdx = (mCurrentBufIdx + 1) % mBuffers.size();
+            mQueuedFrames += got / mFrameSize;
         }
 
         return queued;
@@ -959,43 +1172,43 @@ namespace MWSound
         }
     }
 
-    std::pair<Sound_Handle, size_t> OpenAL_Output::loadSound(const std::string& fname)
+    DecodedSoundPtr OpenAL_Output::decodeSound(const std::string& fname)
     {
-        getALError();
+        auto sound = std::make_shared<DecodedSound>();
+        sound->mName = fname;
+        // Created here as the decoder may do a not thread-safe library initialization
+        sound->mDecoder = mManager.getDecoder();
+        mStreamThread->mDecodeThreads.addSoundJob([sound] { sound->decode(); });
+        return sound;
+    }
 
-        std::vector<char> data;
-        ALenum format = AL_NONE;
-        int srate = 0;
+    bool OpenAL_Output::isSoundDecoded(const DecodedSound& sound)
+    {
+        return sound.mDone.load(std::memory_order_acquire);
+    }
 
-        try
-        {
-            DecoderPtr decoder = mManager.getDecoder();
-            decoder->open(Misc::ResourceHelpers::correctSoundPath(fname, decoder->mResourceMgr));
+    std::pair<Sound_Handle, size_t> OpenAL_Output::loadSound(const DecodedSound& sound)
+    {
+        getALError();
 
-            ChannelConfig chans;
-            SampleType type;
-            decoder->getInfo(&srate, &chans, &type);
-            format = getALFormat(chans, type);
-            if (format)
-                decoder->readAll(data);
-        }
-        catch (std::exception& e)
-        {
-            Log(Debug::Error) << "Failed to load audio from " << fname << ": " << e.what();
-        }
+        const std::vector<char>* data = &sound.mData;
+        ALenum format = data->empty() ? AL_NONE : getALFormat(sound.mChannels, sound.mType);
+        int srate = sound.mSampleRate;
 
-        if (data.empty())
+        std::vector<char> silence;
+        if (format == AL_NONE)
         {
             // If we failed to get any usable audio, substitute with silence.
             format = AL_FORMAT_MONO8;
             srate = 8000;
-            data.assign(8000, -128);
+            silence.assign(8000, -128);
+            data = &silence;
         }
 
         ALint size;
         ALuint buf = 0;
         alGenBuffers(1, &buf);
-        alBufferData(buf, format, data.data(), data.size(), srate);
+        alBufferData(buf, format, data->data(), data->size(), srate);
         alGetBufferi(buf, AL_SIZE, &size);
         if (getALError() != AL_NO_ERROR)
         {
@@ -1249,7 +1462,8 @@ namespace MWSound
         getALError();
     }
 
-    bool OpenAL_Output::streamSound(DecoderPtr decoder, Stream* sound, bool getLoudnessData)
+    bool OpenAL_Output::streamSound(
+        DecoderPtr decoder, Stream* sound, bool getLoudnessData, std::shared_ptr<const Sound_Loudness> loudness)
     {
         if (mFreeSources.empty())
         {
@@ -1267,7 +1481,7 @@ namespace MWSound
             return false;
 
         OpenAL_SoundStream* stream = new OpenAL_SoundStream(source, std::move(decoder));
-        if (!stream->init(getLoudnessData))
+        if (!stream->init(getLoudnessData, std::move(loudness)))
         {
             delete stream;
             return false;
@@ -1280,7 +1494,8 @@ namespace MWSound
         return true;
     }
 
-    bool OpenAL_Output::streamSound3D(DecoderPtr decoder, Stream* sound, bool getLoudnessData)
+    bool OpenAL_Output::streamSound3D(
+        DecoderPtr decoder, Stream* sound, bool getLoudnessData, std::shared_ptr<const Sound_Loudness> loudness)
     {
         if (mFreeSources.empty())
         {
@@ -1298,7 +1513,7 @@ namespace MWSound
             return false;
 
         OpenAL_SoundStream* stream = new OpenAL_SoundStream(source, std::move(decoder));
-        if (!stream->init(getLoudnessData))
+        if (!stream->init(getLoudnessData, std::move(loudness)))
         {
             delete stream;
             return false;
@@ -1359,6 +1574,15 @@ namespace MWSound
         return stream->getCurrentLoudness();
     }
 
+    std::shared_ptr<const Sound_Loudness> OpenAL_Output::getStreamAnalyzedLoudness(Stream* sound)
+    {
+        if (!sound->mHandle)
+            return nullptr;
+        OpenAL_SoundStream* stream = reinterpret_cast<OpenAL_SoundStream*>(sound->mHandle);
+        std::lock_guard<std::mutex> lock(mStreamThread->mMutex);
+        return stream->getAnalyzedLoudness();
+    }
+
     bool OpenAL_Output::isStreamPlaying(Stream* sound)
     {
         if (!sound->mHandle)
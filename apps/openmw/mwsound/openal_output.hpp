@@ -73,7 +73,9 @@ namespace MWSound
         std::vector<std::string> enumerateHrtf() override;
         void setHrtf(const std::string& hrtfname, HrtfMode hrtfmode) override;
 
-        std::pair<Sound_Handle, size_t> loadSound(const std::string& fname) override;
+        DecodedSoundPtr decodeSound(const std::string& fname) override;
+        bool isSoundDecoded(const DecodedSound& sound) override;
+        std::pair<Sound_Handle, size_t> loadSound(const DecodedSound& sound) override;
         size_t unloadSound(Sound_Handle data) override;
 
         bool playSound(Sound* sound, Sound_Handle data, float offset) override;
@@ -82,12 +84,15 @@ namespace MWSound
         bool isSoundPlaying(Sound* sound) override;
         void updateSound(Sound* sound) override;
 
-        bool streamSound(DecoderPtr decoder, Stream* sound, bool getLoudnessData = false) override;
-        bool streamSound3D(DecoderPtr decoder, Stream* sound, bool getLoudnessData) override;
+        bool streamSound(DecoderPtr decoder, Stream* sound, bool getLoudnessData = false,
+            std::shared_ptr<const Sound_Loudness> loudness = nullptr) override;
+        bool streamSound3D(DecoderPtr decoder, Stream* sound, bool getLoudnessData,
+            std::shared_ptr<const Sound_Loudness> loudness = nullptr) override;
         void finishStream(Stream* sound) override;
         double getStreamDelay(Stream* sound) override;
         double getStreamOffset(Stream* sound) override;
         float getStreamLoudness(Stream* sound) override;
+        std::shared_ptr<const Sound_Loudness> getStreamAnalyzedLoudness(Stream* sound) override;
         bool isStreamPlaying(Stream* sound) override;
         void updateStream(Stream* sound) override;
 
@@ -36,7 +36,7 @@ namespace MWSound
         }
     }
 
-    SoundBufferPool::SoundBufferPool(const VFS::Manager& vfs, Sound_Output& output)
+    SoundBufferPool::SoundBufferPool(const VFS::Manager& vfs, Sound_BufferLoader& output)
         : mVfs(&vfs)
         , mOutput(&output)
         , mBufferCacheMax(std::max(Settings::Manager::getInt("buffer cache max", "Sound"), 1) * 1024 * 1024)
@@ -58,7 +58,7 @@ namespace MWSound
         if (it != mBufferNameMap.end())
         {
             Sound_Buffer* sfx = it->second;
-            if (sfx->getHandle() != nullptr)
+            if (sfx->getHandle() != nullptr || sfx->isLoading())
                 return sfx;
         }
         return nullptr;
@@ -85,11 +85,32 @@ namespace MWSound
             sfx = insertSound(soundId, *sound);
         }
 
-        if (sfx->getHandle() == nullptr)
+        if (sfx->getHandle() == nullptr && !sfx->isLoading())
         {
-            auto [handle, size] = mOutput->loadSound(sfx->getResourceName());
+            sfx->mDecoded = mOutput->decodeSound(sfx->getResourceName());
+            mLoadingBuffers.push_back(sfx);
+        }
+
+        return sfx;
+    }
+
+    void SoundBufferPool::update()
+    {
+        auto it = mLoadingBuffers.begin();
+        while (it != mLoadingBuffers.end())
+        {
+            Sound_Buffer* const sfx = *it;
+            if (!mOutput->isSoundDecoded(*sfx->mDecoded))
+            {
+                ++it;
+                continue;
+            }
+
+            auto [handle, size] = mOutput->loadSound(*sfx->mDecoded);
+            sfx->mDecoded = nullptr;
+            it = mLoadingBuffers.erase(it);
             if (handle == nullptr)
-                return {};
+                continue;
 
             sfx->mHandle = handle;
 
@@ -100,10 +121,10 @@ namespace MWSound
                 if (!mUnusedBuffers.empty() && mBufferCacheSize > mBufferCacheMax)
                     Log(Debug::Warning) << "No unused sound buffers to free, using " << mBufferCacheSize << " bytes!";
             }
-            mUnusedBuffers.push_front(sfx);
+            // Buffers released while loading are already there
+            if (sfx->mUses == 0 && std::find(mUnusedBuffers.begin(), mUnusedBuffers.end(), sfx) == mUnusedBuffers.end())
+                mUnusedBuffers.push_front(sfx);
         }
-
-        return sfx;
     }
 
     void SoundBufferPool::clear()
@@ -113,8 +134,10 @@ namespace MWSound
             if (sfx.mHandle)
                 mOutput->unloadSound(sfx.mHandle);
             sfx.mHandle = nullptr;
+            sfx.mDecoded = nullptr;
         }
         mUnusedBuffers.clear();
+        mLoadingBuffers.clear();
     }
 
     Sound_Buffer* SoundBufferPool::insertSound(const std::string& soundId, const ESM::Sound& sound)
@@ -135,9 +158,13 @@ namespace MWSound
         min = std::max(min, 1.0f);
         max = std::max(min, max);
 
-        Sound_Buffer& sfx = mSoundBuffers.emplace_back("Sound/" + sound.mSound, volume, min, max);
-        sfx.mResourceName = mVfs->normalizeFilename(sfx.mResourceName);
+        return insert(soundId, "Sound/" + sound.mSound, volume, min, max);
+    }
 
+    Sound_Buffer* SoundBufferPool::insert(
+        const std::string& soundId, std::string_view resourceName, float volume, float minDist, float maxDist)
+    {
+        Sound_Buffer& sfx = mSoundBuffers.emplace_back(mVfs->normalizeFilename(resourceName), volume, minDist, maxDist);
         mBufferNameMap.emplace(soundId, &sfx);
         return &sfx;
     }
@@ -148,7 +175,8 @@ namespace MWSound
         {
             Sound_Buffer* const unused = mUnusedBuffers.back();
 
-            mBufferCacheSize -= mOutput->unloadSound(unused->getHandle());
+            if (unused->getHandle() != nullptr)
+                mBufferCacheSize -= mOutput->unloadSound(unused->getHandle());
             unused->mHandle = nullptr;
 
             mUnusedBuffers.pop_back();
@@ -4,7 +4,9 @@
 #include <algorithm>
 #include <deque>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
 #include "sound_output.hpp"
 
@@ -38,6 +40,8 @@ namespace MWSound
 
         Sound_Handle getHandle() const noexcept { return mHandle; }
 
+        bool isLoading() const noexcept { return mDecoded != nullptr; }
+
         float getVolume() const noexcept { return mVolume; }
 
         float getMinDist() const noexcept { return mMinDist; }
@@ -50,6 +54,7 @@ namespace MWSound
         float mMinDist;
         float mMaxDist;
         Sound_Handle mHandle = nullptr;
+        DecodedSoundPtr mDecoded;
         std::size_t mUses = 0;
 
         friend class SoundBufferPool;
@@ -58,20 +63,28 @@ namespace MWSound
     class SoundBufferPool
     {
     public:
-        SoundBufferPool(const VFS::Manager& vfs, Sound_Output& output);
+        SoundBufferPool(const VFS::Manager& vfs, Sound_BufferLoader& output);
 
         SoundBufferPool(const SoundBufferPool&) = delete;
 
         ~SoundBufferPool();
 
         /// Lookup a soundId for its sound data (resource name, local volume,
-        /// minRange, and maxRange)
+        /// minRange, and maxRange) if it's loaded or being loaded
         Sound_Buffer* lookup(const std::string& soundId) const;
 
         /// Lookup a soundId for its sound data (resource name, local volume,
-        /// minRange, and maxRange), and ensure it's ready for use.
+        /// minRange, and maxRange), and start loading it in background if it's not loaded.
+        /// The returned buffer is ready for use once its handle is set by update.
         Sound_Buffer* load(const std::string& soundId);
 
+        /// Add a sound which is not a record of the content files
+        Sound_Buffer* insert(
+            const std::string& soundId, std::string_view resourceName, float volume, float minDist, float maxDist);
+
+        /// Finish loading of buffers decoded since the last call
+        void update();
+
         void use(Sound_Buffer& sfx)
         {
             if (sfx.mUses++ == 0)
@@ -92,7 +105,7 @@ namespace MWSound
 
     private:
         const VFS::Manager* const mVfs;
-        Sound_Output* mOutput;
+        Sound_BufferLoader* mOutput;
         std::deque<Sound_Buffer> mSoundBuffers;
         std::unordered_map<std::string, Sound_Buffer*> mBufferNameMap;
         std::size_t mBufferCacheMax;
@@ -100,6 +113,7 @@ namespace MWSound
         std::size_t mBufferCacheSize = 0;
         // NOTE: unused buffers are stored in front-newest order.
         std::deque<Sound_Buffer*> mUnusedBuffers;
+        std::vector<Sound_Buffer*> mLoadingBuffers;
 
         inline Sound_Buffer* insertSound(const std::string& soundId, const ESM::Sound& sound);
 
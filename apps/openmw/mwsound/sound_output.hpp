@@ -13,6 +13,10 @@ namespace MWSound
     struct Sound_Decoder;
     class Sound;
     class Stream;
+    class Sound_Loudness;
+    struct DecodedSound;
+
+    typedef std::shared_ptr<DecodedSound> DecodedSoundPtr;
 
     // An opaque handle for the implementation's sound buffers.
     typedef void* Sound_Handle;
@@ -32,7 +36,21 @@ namespace MWSound
         Env_Underwater
     };
 
-    class Sound_Output
+    // Loading of sound buffers, used by SoundBufferPool
+    class Sound_BufferLoader
+    {
+    public:
+        virtual ~Sound_BufferLoader() {}
+
+        /// Start decoding the file in a background thread. The result can be passed to loadSound once
+        /// isSoundDecoded returns true.
+        virtual DecodedSoundPtr decodeSound(const std::string& fname) = 0;
+        virtual bool isSoundDecoded(const DecodedSound& sound) = 0;
+        virtual std::pair<Sound_Handle, size_t> loadSound(const DecodedSound& sound) = 0;
+        virtual size_t unloadSound(Sound_Handle data) = 0;
+    };
+
+    class Sound_Output : public Sound_BufferLoader
     {
         SoundManager& mManager;
 
@@ -43,21 +61,26 @@ namespace MWSound
         virtual std::vector<std::string> enumerateHrtf() = 0;
         virtual void setHrtf(const std::string& hrtfname, HrtfMode hrtfmode) = 0;
 
-        virtual std::pair<Sound_Handle, size_t> loadSound(const std::string& fname) = 0;
-        virtual size_t unloadSound(Sound_Handle data) = 0;
-
         virtual bool playSound(Sound* sound, Sound_Handle data, float offset) = 0;
         virtual bool playSound3D(Sound* sound, Sound_Handle data, float offset) = 0;
         virtual void finishSound(Sound* sound) = 0;
         virtual bool isSoundPlaying(Sound* sound) = 0;
         virtual void updateSound(Sound* sound) = 0;
 
-        virtual bool streamSound(DecoderPtr decoder, Stream* sound, bool getLoudnessData = false) = 0;
-        virtual bool streamSound3D(DecoderPtr decoder, Stream* sound, bool getLoudnessData) = 0;
+        /// Loudness of the stream is taken from \a loudness if it's computed already, otherwise it's computed
+        /// while playing if \a getLoudnessData is true.
+        virtual bool streamSound(DecoderPtr decoder, Stream* sound, bool getLoudnessData = false,
+            std::shared_ptr<const Sound_Loudness> loudness = nullptr)
+            = 0;
+        virtual bool streamSound3D(DecoderPtr decoder, Stream* sound, bool getLoudnessData,
+            std::shared_ptr<const Sound_Loudness> loudness = nullptr)
+            = 0;
         virtual void finishStream(Stream* sound) = 0;
         virtual double getStreamDelay(Stream* sound) = 0;
         virtual double getStreamOffset(Stream* sound) = 0;
         virtual float getStreamLoudness(Stream* sound) = 0;
+        /// Loudness analyzed while playing the stream once all of its audio is analyzed, otherwise null.
+        virtual std::shared_ptr<const Sound_Loudness> getStreamAnalyzedLoudness(Stream* sound) = 0;
         virtual bool isStreamPlaying(Stream* sound) = 0;
         virtual void updateStream(Stream* sound) = 0;
 
@@ -93,7 +116,6 @@ namespace MWSound
 
         friend class OpenAL_Output;
         friend class SoundManager;
-        friend class SoundBufferPool;
     };
 }
 
@@ -27,6 +27,7 @@
 #include "sound_output.hpp"
 
 #include "ffmpeg_decoder.hpp"
+#include "loudnesscache.hpp"
 #include "openal_output.hpp"
 
 namespace MWSound
@@ -78,7 +79,7 @@ namespace MWSound
         return static_cast<int>(a) | static_cast<int>(b);
     }
 
-    SoundManager::SoundManager(const VFS::Manager* vfs, bool useSound)
+    SoundManager::SoundManager(const VFS::Manager* vfs, bool useSound, const std::filesystem::path& cachePath)
         : mVFS(vfs)
         , mOutput(new OpenAL_Output(*this))
         , mWaterSoundUpdater(makeWaterSoundUpdaterSettings())
@@ -111,6 +112,9 @@ namespace MWSound
             return;
         }
 
+        if (Settings::Manager::getBool("loudness cache", "Sound"))
+            mLoudnessCache = std::make_unique<LoudnessCache>(*vfs, cachePath / "loudness.bin");
+
         std::vector<std::string> names = mOutput->enumerate();
         std::stringstream stream;
 
@@ -171,7 +175,26 @@ namespace MWSound
         return mStreams.get();
     }
 
-    StreamPtr SoundManager::playVoice(DecoderPtr decoder, const osg::Vec3f& pos, bool playlocal)
+    std::shared_ptr<const Sound_Loudness> SoundManager::getVoiceLoudness(const std::string& voicefile) const
+    {
+        if (mLoudnessCache == nullptr)
+            return nullptr;
+
+        return mLoudnessCache->get(Misc::ResourceHelpers::correctSoundPath(voicefile, mVFS));
+    }
+
+    void SoundManager::keepVoiceLoudness(const SaySound& say)
+    {
+        if (mLoudnessCache == nullptr || say.mVoiceFile.empty())
+            return;
+
+        std::shared_ptr<const Sound_Loudness> loudness = mOutput->getStreamAnalyzedLoudness(say.mStream.get());
+        if (loudness != nullptr)
+            mLoudnessCache->add(Misc::ResourceHelpers::correctSoundPath(say.mVoiceFile, mVFS), std::move(loudness));
+    }
+
+    StreamPtr SoundManager::playVoice(
+        DecoderPtr decoder, const osg::Vec3f& pos, bool playlocal, std::shared_ptr<const Sound_Loudness> loudness)
     {
         MWBase::World* world = MWBase::Environment::get().getWorld();
         static const float fAudioMinDistanceMult
@@ -196,7 +219,7 @@ namespace MWSound
                 params.mFlags = PlayMode::NoEnv | Type::Voice | Play_2D;
                 return params;
             }());
-            played = mOutput->streamSound(decoder, sound.get(), true);
+            played = mOutput->streamSound(decoder, sound.get(), true, std::move(loudness));
         }
         else
         {
@@ -209,13 +232,63 @@ namespace MWSound
                 params.mFlags = PlayMode::Normal | Type::Voice | Play_3D;
                 return params;
             }());
-            played = mOutput->streamSound3D(decoder, sound.get(), true);
+            played = mOutput->streamSound3D(decoder, sound.get(), true, std::move(loudness));
         }
         if (!played)
             return nullptr;
         return sound;
     }
 
+    bool SoundManager::startSound(Sound* sound, Sound_Buffer* sfx, float offset)
+    {
+        if (sfx->getHandle() == nullptr)
+        {
+            mPendingSounds.push_back(PendingSound{ sound, sfx, offset });
+            return true;
+        }
+        if (sound->getIs3D())
+            return mOutput->playSound3D(sound, sfx->getHandle(), offset);
+        return mOutput->playSound(sound, sfx->getHandle(), offset);
+    }
+
+    void SoundManager::startPendingSounds()
+    {
+        auto it = mPendingSounds.begin();
+        while (it != mPendingSounds.end())
+        {
+            if (it->mSfx->isLoading())
+            {
+                ++it;
+                continue;
+            }
+            // A sound failed to load or play is not playing, so it's removed by the next update
+            if (it->mSfx->getHandle() != nullptr)
+            {
+                if (it->mSound->getIs3D())
+                    mOutput->playSound3D(it->mSound, it->mSfx->getHandle(), it->mOffset);
+                else
+                    mOutput->playSound(it->mSound, it->mSfx->getHandle(), it->mOffset);
+            }
+            it = mPendingSounds.erase(it);
+        }
+    }
+
+    bool SoundManager::isSoundPlaying(Sound* sound) const
+    {
+        const auto isSound = [&](const PendingSound& pending) { return pending.mSound == sound; };
+        if (std::any_of(mPendingSounds.begin(), mPendingSounds.end(), isSound))
+            return true;
+        return mOutput->isSoundPlaying(sound);
+    }
+
+    void SoundManager::finishSound(Sound* sound)
+    {
+        const auto isSound = [&](const PendingSound& pending) { return pending.mSound == sound; };
+        mPendingSounds.erase(
+            std::remove_if(mPendingSounds.begin(), mPendingSounds.end(), isSound), mPendingSounds.end());
+        mOutput->finishSound(sound);
+    }
+
     // Gets the combined volume settings for the given sound type
     float SoundManager::volumeFromType(Type type) const
     {
@@ -366,7 +439,8 @@ namespace MWSound
         if (!mOutput->isInitialized())
             return;
 
-        DecoderPtr decoder = loadVoice(mVFS->normalizeFilename("Sound/" + filename));
+        const std::string voicefile = mVFS->normalizeFilename("Sound/" + filename);
+        DecoderPtr decoder = loadVoice(voicefile);
         if (!decoder)
             return;
 
@@ -374,11 +448,13 @@ namespace MWSound
         const osg::Vec3f pos = world->getActorHeadTransform(ptr).getTrans();
 
         stopSay(ptr);
-        StreamPtr sound = playVoice(decoder, pos, (ptr == MWMechanics::getPlayer()));
+        std::shared_ptr<const Sound_Loudness> loudness = getVoiceLoudness(voicefile);
+        const bool analyze = loudness == nullptr;
+        StreamPtr sound = playVoice(decoder, pos, (ptr == MWMechanics::getPlayer()), std::move(loudness));
         if (!sound)
             return;
 
-        mSaySoundsQueue.emplace(ptr.mRef, SaySound{ ptr.mCell, std::move(sound) });
+        mSaySoundsQueue.emplace(ptr.mRef, SaySound{ ptr.mCell, std::move(sound), analyze ? voicefile : std::string() });
     }
 
     float SoundManager::getSaySoundLoudness(const MWWorld::ConstPtr& ptr) const
@@ -398,16 +474,19 @@ namespace MWSound
         if (!mOutput->isInitialized())
             return;
 
-        DecoderPtr decoder = loadVoice(mVFS->normalizeFilename("Sound/" + filename));
+        const std::string voicefile = mVFS->normalizeFilename("Sound/" + filename);
+        DecoderPtr decoder = loadVoice(voicefile);
         if (!decoder)
             return;
 
         stopSay(MWWorld::ConstPtr());
-        StreamPtr sound = playVoice(decoder, osg::Vec3f(), true);
+        std::shared_ptr<const Sound_Loudness> loudness = getVoiceLoudness(voicefile);
+        const bool analyze = loudness == nullptr;
+        StreamPtr sound = playVoice(decoder, osg::Vec3f(), true, std::move(loudness));
         if (!sound)
             return;
 
-        mActiveSaySounds.emplace(nullptr, SaySound{ nullptr, std::move(sound) });
+        mActiveSaySounds.emplace(nullptr, SaySound{ nullptr, std::move(sound), analyze ? voicefile : std::string() });
     }
 
     bool SoundManager::sayDone(const MWWorld::ConstPtr& ptr) const
@@ -517,7 +596,7 @@ namespace MWSound
             params.mFlags = mode | type | Play_2D;
             return params;
         }());
-        if (!mOutput->playSound(sound.get(), sfx->getHandle(), offset))
+        if (!startSound(sound.get(), sfx, offset))
             return nullptr;
 
         Sound* result = sound.get();
@@ -557,7 +636,7 @@ namespace MWSound
                 params.mFlags = mode | type | Play_2D;
                 return params;
             }());
-            played = mOutput->playSound(sound.get(), sfx->getHandle(), offset);
+            played = startSound(sound.get(), sfx, offset);
         }
         else
         {
@@ -573,7 +652,7 @@ namespace MWSound
                 params.mFlags = mode | type | Play_3D;
                 return params;
             }());
-            played = mOutput->playSound3D(sound.get(), sfx->getHandle(), offset);
+            played = startSound(sound.get(), sfx, offset);
         }
         if (!played)
             return nullptr;
@@ -613,7 +692,7 @@ namespace MWSound
             params.mFlags = mode | type | Play_3D;
             return params;
         }());
-        if (!mOutput->playSound3D(sound.get(), sfx->getHandle(), offset))
+        if (!startSound(sound.get(), sfx, offset))
             return nullptr;
 
         Sound* result = sound.get();
@@ -625,7 +704,7 @@ namespace MWSound
     void SoundManager::stopSound(Sound* sound)
     {
         if (sound)
-            mOutput->finishSound(sound);
+            finishSound(sound);
     }
 
     void SoundManager::stopSound(Sound_Buffer* sfx, const MWWorld::ConstPtr& ptr)
@@ -636,7 +715,7 @@ namespace MWSound
             for (SoundBufferRefPair& snd : snditer->second.mList)
             {
                 if (snd.second == sfx)
-                    mOutput->finishSound(snd.first.get());
+                    finishSound(snd.first.get());
             }
         }
     }
@@ -659,7 +738,7 @@ namespace MWSound
         if (snditer != mActiveSounds.end())
         {
             for (SoundBufferRefPair& snd : snditer->second.mList)
-                mOutput->finishSound(snd.first.get());
+                finishSound(snd.first.get());
         }
         SaySoundMap::iterator sayiter = mSaySoundsQueue.find(ptr.mRef);
         if (sayiter != mSaySoundsQueue.end())
@@ -676,7 +755,7 @@ namespace MWSound
             if (ref != nullptr && ref != MWMechanics::getPlayer().mRef && sound.mCell == cell)
             {
                 for (SoundBufferRefPair& sndbuf : sound.mList)
-                    mOutput->finishSound(sndbuf.first.get());
+                    finishSound(sndbuf.first.get());
             }
         }
 
@@ -717,7 +796,7 @@ namespace MWSound
             Sound_Buffer* sfx = mSoundBuffers.lookup(Misc::StringUtils::lowerCase(soundId));
             return std::find_if(snditer->second.mList.cbegin(), snditer->second.mList.cend(),
                        [this, sfx](const SoundBufferRefPair& snd) -> bool {
-                           return snd.second == sfx && mOutput->isSoundPlaying(snd.first.get());
+                           return snd.second == sfx && isSoundPlaying(snd.first.get());
                        })
                 != snditer->second.mList.cend();
         }
@@ -779,7 +858,7 @@ namespace MWSound
 
         if (!cell->isExterior())
             return;
-        if (mCurrentRegionSound && mOutput->isSoundPlaying(mCurrentRegionSound))
+        if (mCurrentRegionSound && isSoundPlaying(mCurrentRegionSound))
             return;
 
         if (const auto next = mRegionSoundSelector.getNextRandom(duration, cell->mRegion, *world))
@@ -810,7 +889,7 @@ namespace MWSound
                 break;
             case WaterSoundAction::PlaySound:
                 if (mNearWaterSound)
-                    mOutput->finishSound(mNearWaterSound);
+                    finishSound(mNearWaterSound);
                 mNearWaterSound = playSound(update.mId, update.mVolume, 1.0f, Type::Sfx, PlayMode::Loop);
                 break;
         }
@@ -892,6 +971,9 @@ namespace MWSound
             mSaySoundsQueue.erase(queuesayiter++);
         }
 
+        // Sounds are started as soon as possible, their buffers may be decoded by now
+        startPendingSounds();
+
         mTimePassed += duration;
         if (mTimePassed < sMinUpdateInterval)
             return;
@@ -907,7 +989,7 @@ namespace MWSound
             env = Env_Underwater;
         else if (mUnderwaterSound)
         {
-            mOutput->finishSound(mUnderwaterSound);
+            finishSound(mUnderwaterSound);
             mUnderwaterSound = nullptr;
         }
 
@@ -934,9 +1016,9 @@ namespace MWSound
                     cull3DSound(sound);
                 }
 
-                if (!sound->updateFade(duration) || !mOutput->isSoundPlaying(sound))
+                if (!sound->updateFade(duration) || !isSoundPlaying(sound))
                 {
-                    mOutput->finishSound(sound);
+                    finishSound(sound);
                     if (sound == mUnderwaterSound)
                         mUnderwaterSound = nullptr;
                     if (sound == mNearWaterSound)
@@ -974,6 +1056,7 @@ namespace MWSound
 
             if (!sound->updateFade(duration) || !mOutput->isStreamPlaying(sound))
             {
+                keepVoiceLoudness(sayiter->second);
                 mOutput->finishStream(sound);
                 sayiter = mActiveSaySounds.erase(sayiter);
             }
@@ -1029,7 +1112,14 @@ namespace MWSound
 
     void SoundManager::update(float duration)
     {
-        if (!mOutput->isInitialized() || mPlaybackPaused)
+        if (!mOutput->isInitialized())
+            return;
+
+        // Decoded buffers are finished even when playback is paused or nothing waits for them anymore,
+        // otherwise their decoded data is kept and they are never accounted in the cache size
+        mSoundBuffers.update();
+
+        if (mPlaybackPaused)
             return;
 
         updateSounds(duration);
@@ -1202,7 +1292,7 @@ namespace MWSound
         {
             for (SoundBufferRefPair& sndbuf : snd.second.mList)
             {
-                mOutput->finishSound(sndbuf.first.get());
+                finishSound(sndbuf.first.get());
                 mSoundBuffers.release(*sndbuf.second);
             }
         }
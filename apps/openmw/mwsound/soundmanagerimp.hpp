@@ -1,6 +1,7 @@
 #ifndef GAME_SOUND_SOUNDMANAGER_H
 #define GAME_SOUND_SOUNDMANAGER_H
 
+#include <filesystem>
 #include <map>
 #include <memory>
 #include <string>
@@ -37,6 +38,8 @@ namespace MWSound
     class SoundBase;
     class Sound;
     class Stream;
+    class Sound_Loudness;
+    class LoudnessCache;
 
     using SoundPtr = Misc::ObjectPtr<Sound>;
     using StreamPtr = Misc::ObjectPtr<Stream>;
@@ -58,6 +61,8 @@ namespace MWSound
 
         SoundBufferPool mSoundBuffers;
 
+        std::unique_ptr<LoudnessCache> mLoudnessCache;
+
         Misc::ObjectPool<Sound> mSounds;
 
         Misc::ObjectPool<Stream> mStreams;
@@ -74,10 +79,22 @@ namespace MWSound
         typedef std::map<const MWWorld::LiveCellRefBase*, ActiveSound> SoundMap;
         SoundMap mActiveSounds;
 
+        // Active sounds waiting for their buffers to be loaded
+        struct PendingSound
+        {
+            Sound* mSound;
+            Sound_Buffer* mSfx;
+            float mOffset;
+        };
+
+        std::vector<PendingSound> mPendingSounds;
+
         struct SaySound
         {
             const MWWorld::CellStore* mCell;
             StreamPtr mStream;
+            // Set when loudness of the voice is analyzed while playing, to keep it in the loudness cache
+            std::string mVoiceFile;
         };
 
         typedef std::map<const MWWorld::LiveCellRefBase*, SaySound> SaySoundMap;
@@ -119,7 +136,20 @@ namespace MWSound
         SoundPtr getSoundRef();
         StreamPtr getStreamRef();
 
-        StreamPtr playVoice(DecoderPtr decoder, const osg::Vec3f& pos, bool playlocal);
+        // returns loudness of the voice if it's analyzed already
+        std::shared_ptr<const Sound_Loudness> getVoiceLoudness(const std::string& voicefile) const;
+
+        // keeps loudness of the finished voice in the loudness cache if it was analyzed while playing
+        void keepVoiceLoudness(const SaySound& say);
+
+        StreamPtr playVoice(DecoderPtr decoder, const osg::Vec3f& pos, bool playlocal,
+            std::shared_ptr<const Sound_Loudness> loudness);
+
+        // Plays the sound once its buffer is loaded
+        bool startSound(Sound* sound, Sound_Buffer* sfx, float offset);
+        void startPendingSounds();
+        bool isSoundPlaying(Sound* sound) const;
+        void finishSound(Sound* sound);
 
         void streamMusicFull(const std::string& filename);
         void advanceMusic(const std::string& filename);
@@ -156,7 +186,7 @@ namespace MWSound
         ///< Stop the given object from playing given sound buffer.
 
     public:
-        SoundManager(const VFS::Manager* vfs, bool useSound);
+        SoundManager(const VFS::Manager* vfs, bool useSound, const std::filesystem::path& cachePath);
         ~SoundManager() override;
 
         void processChangedSettings(const Settings::CategorySettingVector& settings) override;
@@ -0,0 +1,116 @@
+#include "asyncsavewriter.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <stdexcept>
+
+#include <components/debug/debuglog.hpp>
+#include <components/files/conversion.hpp>
+
+namespace
+{
+    void writeFile(const std::filesystem::path& path, const std::string& data)
+    {
+        std::filesystem::path tmpPath = path;
+        tmpPath += ".tmp";
+
+        {
+            std::ofstream stream(tmpPath, std::ios::binary);
+            stream.write(data.data(), static_cast<std::streamsize>(data.size()));
+            stream.close();
+            if (stream.fail())
+            {
+                std::error_code ec;
+                std::filesystem::remove(tmpPath, ec);
+                throw std::runtime_error("Write operation failed (file stream)");
+            }
+        }
+
+        std::filesystem::rename(tmpPath, path);
+    }
+}
+
+MWState::AsyncSaveWriter::AsyncSaveWriter()
+    : mWriting(false)
+    , mShouldStop(false)
+    , mThread([this] { run(); })
+{
+}
+
+MWState::AsyncSaveWriter::~AsyncSaveWriter()
+{
+    {
+        std::lock_guard lock(mMutex);
+        mShouldStop = true;
+    }
+    mHasJob.notify_all();
+    mThread.join();
+}
+
+void MWState::AsyncSaveWriter::write(const std::filesystem::path& path, std::string data)
+{
+    {
+        std::lock_guard lock(mMutex);
+        mJobs.push_back(Job{ path, std::move(data) });
+    }
+    mHasJob.notify_all();
+}
+
+void MWState::AsyncSaveWriter::wait()
+{
+    std::unique_lock lock(mMutex);
+    mDone.wait(lock, [&] { return mJobs.empty() && !mWriting; });
+}
+
+std::vector<MWState::AsyncSaveWriter::Failure> MWState::AsyncSaveWriter::takeFailures()
+{
+    std::lock_guard lock(mMutex);
+    std::vector<Failure> result;
+    result.swap(mFailures);
+    return result;
+}
+
+void MWState::AsyncSaveWriter::run()
+{
+    std::unique_lock lock(mMutex);
+    while (true)
+    {
+        // Pending files are still written on stop, otherwise saved games requested before quit are lost
+        mHasJob.wait(lock, [&] { return mShouldStop || !mJobs.empty(); });
+        if (mJobs.empty())
+            break;
+
+        Job job = std::move(mJobs.front());
+        mJobs.pop_front();
+        mWriting = true;
+        lock.unlock();
+
+        const auto start = std::chrono::steady_clock::now();
+        std::string error;
+        try
+        {
+            writeFile(job.mPath, job.mData);
+        }
+        catch (const std::exception& e)
+        {
+            error = e.what();
+        }
+        const auto finish = std::chrono::steady_clock::now();
+
+        if (error.empty())
+            Log(Debug::Info) << "Saved game file " << Files::pathToUnicodeString(job.mPath.filename())
+                             << " is written in "
+                             << std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(finish - start)
+                                    .count()
+                             << "ms";
+        else
+            Log(Debug::Error) << "Failed to write saved game file " << Files::pathToUnicodeString(job.mPath) << ": "
+                              << error;
+
+        lock.lock();
+        if (!error.empty())
+            mFailures.push_back(Failure{ std::move(job.mPath), std::move(error) });
+        mWriting = false;
+        mDone.notify_all();
+    }
+}
@@ -0,0 +1,61 @@
+#ifndef GAME_STATE_ASYNCSAVEWRITER_H
+#define GAME_STATE_ASYNCSAVEWRITER_H
+
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace MWState
+{
+    class AsyncSaveWriter
+    {
+    public:
+        struct Failure
+        {
+            std::filesystem::path mPath;
+            std::string mMessage;
+        };
+
+        AsyncSaveWriter();
+        ///< A utility class to write serialized saved games to disk in a background thread.
+        ///
+        /// Files are written in the order they are requested. A file is first written next to the destination and
+        /// then renamed, so an existing saved game is never left partially overwritten.
+
+        ~AsyncSaveWriter();
+        ///< Waits for pending files to be written.
+
+        void write(const std::filesystem::path& path, std::string data);
+        ///< Queue \a data to be written into the file at \a path.
+
+        void wait();
+        ///< Block until all queued files are written.
+
+        std::vector<Failure> takeFailures();
+        ///< Get failures of writes done since the last call.
+
+    private:
+        struct Job
+        {
+            std::filesystem::path mPath;
+            std::string mData;
+        };
+
+        std::mutex mMutex;
+        std::condition_variable mHasJob;
+        std::condition_variable mDone;
+        std::deque<Job> mJobs;
+        bool mWriting;
+        bool mShouldStop;
+        std::vector<Failure> mFailures;
+        std::thread mThread;
+
+        void run();
+    };
+}
+
+#endif
@@ -0,0 +1,81 @@
+#include "blockdecompressor.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <components/misc/compression.hpp>
+
+MWState::BlockDecompressor::BlockDecompressor(std::vector<std::vector<std::byte>>&& blocks)
+    : mNext(0)
+    , mTaken(0)
+    , mShouldStop(false)
+{
+    mBlocks.reserve(blocks.size());
+    for (std::vector<std::byte>& block : blocks)
+        mBlocks.push_back(Block{ std::move(block), std::nullopt, nullptr });
+
+    const std::size_t threads
+        = std::min<std::size_t>(std::max(std::thread::hardware_concurrency(), 1u), mBlocks.size());
+    // Don't decompress too far ahead of the reader to not keep the whole saved game in memory
+    mMaxAhead = 2 * threads;
+    mThreads.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i)
+        mThreads.emplace_back([this] { run(); });
+}
+
+MWState::BlockDecompressor::~BlockDecompressor()
+{
+    {
+        std::lock_guard lock(mMutex);
+        mShouldStop = true;
+    }
+    mHasSpace.notify_all();
+    for (std::thread& thread : mThreads)
+        thread.join();
+}
+
+std::vector<std::byte> MWState::BlockDecompressor::get(std::size_t index)
+{
+    std::unique_lock lock(mMutex);
+    Block& block = mBlocks.at(index);
+    mDone.wait(lock, [&] { return block.mDecompressed.has_value() || block.mError != nullptr; });
+    if (block.mError != nullptr)
+        std::rethrow_exception(block.mError);
+    std::vector<std::byte> result = std::move(*block.mDecompressed);
+    block.mDecompressed = std::vector<std::byte>();
+    ++mTaken;
+    lock.unlock();
+    mHasSpace.notify_all();
+    return result;
+}
+
+void MWState::BlockDecompressor::run()
+{
+    std::unique_lock lock(mMutex);
+    while (true)
+    {
+        mHasSpace.wait(lock, [&] { return mShouldStop || mNext < mTaken + mMaxAhead; });
+        if (mShouldStop || mNext >= mBlocks.size())
+            break;
+
+        Block& block = mBlocks[mNext++];
+        const std::vector<std::byte> compressed = std::move(block.mCompressed);
+        lock.unlock();
+
+        std::optional<std::vector<std::byte>> decompressed;
+        std::exception_ptr error;
+        try
+        {
+            decompressed = Misc::decompress(compressed);
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+
+        lock.lock();
+        block.mDecompressed = std::move(decompressed);
+        block.mError = error;
+        mDone.notify_all();
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef GAME_STATE_BLOCKDECOMPRESSOR_H
+#define GAME_STATE_BLOCKDECOMPRESSOR_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace MWState
+{
+    class BlockDecompressor
+    {
+    public:
+        explicit BlockDecompressor(std::vector<std::vector<std::byte>>&& blocks);
+        ///< A utility class to decompress blocks of a saved game in background threads.
+        ///
+        /// Blocks are independent from each other, so they are decompressed in parallel while the caller reads the
+        /// records of already decompressed ones.
+
+        ~BlockDecompressor();
+        ///< Stops decompressing the blocks which are not started yet.
+
+        std::size_t getSize() const { return mBlocks.size(); }
+
+        std::vector<std::byte> get(std::size_t index);
+        ///< Block until the block with \a index is decompressed and take it. Blocks must be taken once each, in order.
+        /// \note Rethrows an exception thrown while decompressing the block.
+
+    private:
+        struct Block
+        {
+            std::vector<std::byte> mCompressed;
+            std::optional<std::vector<std::byte>> mDecompressed;
+            std::exception_ptr mError;
+        };
+
+        std::mutex mMutex;
+        std::condition_variable mDone;
+        std::condition_variable mHasSpace;
+        std::vector<Block> mBlocks;
+        std::size_t mNext;
+        std::size_t mTaken;
+        std::size_t mMaxAhead;
+        bool mShouldStop;
+        std::vector<std::thread> mThreads;
+
+        void run();
+    };
+}
+
+#endif
@@ -1,5 +1,6 @@
 #include "statemanagerimp.hpp"
 
+#include <algorithm>
 #include <filesystem>
 
 #include <components/debug/debuglog.hpp>
@@ -41,8 +42,15 @@
 
 #include "../mwscript/globalscripts.hpp"
 
+#include "blockdecompressor.hpp"
 #include "quicksavemanager.hpp"
 
+namespace
+{
+    // Big enough to get a good compression ratio and small enough to not hold much memory while reading
+    constexpr std::size_t compressionBlockSize = 1024 * 1024;
+}
+
 void MWState::StateManager::cleanup(bool force)
 {
     if (mState != State_NoGame || force)
@@ -188,6 +196,11 @@ void MWState::StateManager::resumeGame()
 
 void MWState::StateManager::saveGame(const std::string& description, const Slot* slot)
 {
+    // Slots are matched to files by path, so the previous saved game has to be on disk before making a new one
+    mSaveWriter.wait();
+    for (const AsyncSaveWriter::Failure& failure : mSaveWriter.takeFailures())
+        reportFailedSave(failure.mMessage, failure.mPath);
+
     MWState::Character* character = getCurrentCharacter();
 
     try
@@ -281,6 +294,10 @@ void MWState::StateManager::saveGame(const std::string& description, const Slot*
         slot->mProfile.save(writer);
         writer.endRecord(ESM::REC_SAVE);
 
+        // The profile is kept uncompressed to read it without touching the rest of the file when listing saves
+        if (Settings::Manager::getBool("compress", "Saves"))
+            writer.setCompressionBlockSize(compressionBlockSize);
+
         MWBase::Environment::get().getJournal()->write(writer, listener);
         MWBase::Environment::get().getDialogueManager()->write(writer, listener);
         // LuaManager::write should be called before World::write because world also saves
@@ -302,40 +319,45 @@ void MWState::StateManager::saveGame(const std::string& description, const Slot*
         if (stream.fail())
             throw std::runtime_error("Write operation failed (memory stream)");
 
-        // All good, write to file
-        std::ofstream filestream(slot->mPath, std::ios::binary);
-        filestream << stream.rdbuf();
-
-        if (filestream.fail())
-            throw std::runtime_error("Write operation failed (file stream)");
+        // All good, write to file in background, the game state is not accessed anymore
+        mSaveWriter.write(slot->mPath, stream.str());
 
         Settings::Manager::setString(
             "character", "Saves", Files::pathToUnicodeString(slot->mPath.parent_path().filename()));
 
         const auto finish = std::chrono::steady_clock::now();
 
-        Log(Debug::Info) << '\'' << description << "' is saved in "
+        Log(Debug::Info) << '\'' << description << "' is serialized in "
                          << std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(finish - start).count()
                          << "ms";
     }
     catch (const std::exception& e)
     {
-        std::stringstream error;
-        error << "Failed to save game: " << e.what();
+        reportFailedSave(e.what(), slot != nullptr ? slot->mPath : std::filesystem::path());
+    }
+}
 
-        Log(Debug::Error) << error.str();
+void MWState::StateManager::reportFailedSave(const std::string& message, const std::filesystem::path& path)
+{
+    std::stringstream error;
+    error << "Failed to save game: " << message;
 
-        std::vector<std::string> buttons;
-        buttons.emplace_back("#{sOk}");
-        MWBase::Environment::get().getWindowManager()->interactiveMessageBox(error.str(), buttons);
+    Log(Debug::Error) << error.str();
 
-        // If no file was written, clean up the slot
-        if (character && slot && !std::filesystem::exists(slot->mPath))
-        {
-            character->deleteSlot(slot);
-            character->cleanup();
-        }
-    }
+    std::vector<std::string> buttons;
+    buttons.emplace_back("#{sOk}");
+    MWBase::Environment::get().getWindowManager()->interactiveMessageBox(error.str(), buttons);
+
+    // If no file was written, clean up the slot
+    Character* character = getCurrentCharacter();
+    if (character == nullptr || path.empty() || std::filesystem::exists(path))
+        return;
+    const auto slot = std::find_if(
+        character->begin(), character->end(), [&](const Slot& v) { return v.mPath == path; });
+    if (slot == character->end())
+        return;
+    character->deleteSlot(&*slot);
+    character->cleanup();
 }
 
 void MWState::StateManager::quickSave(std::string name)
@@ -390,6 +412,8 @@ void MWState::StateManager::loadGame(const std::filesystem::path& filepath)
 
 void MWState::StateManager::loadGame(const Character* character, const std::filesystem::path& filepath)
 {
+    mSaveWriter.wait();
+
     try
     {
         cleanup();
@@ -418,6 +442,14 @@ void MWState::StateManager::loadGame(const Character* character, const std::file
 
         size_t total = reader.getFileSize();
         int currentPercent = 0;
+        const auto updateProgress = [&](std::size_t offset) {
+            int progressPercent = static_cast<int>(float(offset) / total * 100);
+            if (progressPercent > currentPercent)
+            {
+                listener.increaseProgress(progressPercent - currentPercent);
+                currentPercent = progressPercent;
+            }
+        };
         while (reader.hasMoreRecs())
         {
             ESM::NAME n = reader.getRecName();
@@ -441,88 +473,40 @@ void MWState::StateManager::loadGame(const Character* character, const std::file
                 }
                 break;
 
-                case ESM::REC_JOUR:
-                case ESM::REC_JOUR_LEGACY:
-                case ESM::REC_QUES:
-
-                    MWBase::Environment::get().getJournal()->readRecord(reader, n.toInt());
-                    break;
-
-                case ESM::REC_DIAS:
-
-                    MWBase::Environment::get().getDialogueManager()->readRecord(reader, n.toInt());
-                    break;
-
-                case ESM::REC_ALCH:
-                case ESM::REC_ARMO:
-                case ESM::REC_BOOK:
-                case ESM::REC_CLAS:
-                case ESM::REC_CLOT:
-                case ESM::REC_ENCH:
-                case ESM::REC_NPC_:
-                case ESM::REC_SPEL:
-                case ESM::REC_WEAP:
-                case ESM::REC_GLOB:
-                case ESM::REC_PLAY:
-                case ESM::REC_CSTA:
-                case ESM::REC_WTHR:
-                case ESM::REC_DYNA:
-                case ESM::REC_ACTC:
-                case ESM::REC_PROJ:
-                case ESM::REC_MPRJ:
-                case ESM::REC_ENAB:
-                case ESM::REC_LEVC:
-                case ESM::REC_LEVI:
-                case ESM::REC_CREA:
-                case ESM::REC_CONT:
-                case ESM::REC_RAND:
-                    MWBase::Environment::get().getWorld()->readRecord(reader, n.toInt(), contentFileMap);
-                    break;
-
-                case ESM::REC_CAM_:
-                    reader.getHNT(firstPersonCam, "FIRS");
-                    break;
-
-                case ESM::REC_GSCR:
-
-                    MWBase::Environment::get().getScriptManager()->getGlobalScripts().readRecord(
-                        reader, n.toInt(), contentFileMap);
-                    break;
-
-                case ESM::REC_GMAP:
-                case ESM::REC_KEYS:
-                case ESM::REC_ASPL:
-                case ESM::REC_MARK:
-
-                    MWBase::Environment::get().getWindowManager()->readRecord(reader, n.toInt());
-                    break;
-
-                case ESM::REC_DCOU:
-                case ESM::REC_STLN:
-
-                    MWBase::Environment::get().getMechanicsManager()->readRecord(reader, n.toInt());
-                    break;
-
-                case ESM::REC_INPU:
-                    MWBase::Environment::get().getInputManager()->readRecord(reader, n.toInt());
-                    break;
-
-                case ESM::REC_LUAM:
-                    MWBase::Environment::get().getLuaManager()->readRecord(reader, n.toInt());
-                    break;
+                case ESM::REC_ZBLK:
+                {
+                    // Blocks go one after another, read them all to decompress in parallel with reading the records
+                    std::vector<std::vector<std::byte>> blocks;
+                    std::vector<std::size_t> offsets;
+                    while (true)
+                    {
+                        blocks.push_back(reader.getCompressedBlock());
+                        offsets.push_back(reader.getFileOffset());
+                        if (!reader.hasMoreRecs() || reader.getRecName().toInt() != ESM::REC_ZBLK)
+                            break;
+                        reader.getRecHeader();
+                    }
 
-                default:
+                    BlockDecompressor decompressor(std::move(blocks));
+                    for (std::size_t i = 0; i < decompressor.getSize(); ++i)
+                    {
+                        ESM::ESMReader block;
+                        block.openDecompressedBlock(reader, decompressor.get(i));
+                        while (block.hasMoreRecs())
+                        {
+                            const ESM::NAME blockRecord = block.getRecName();
+                            block.getRecHeader();
+                            readRecord(block, blockRecord.toInt(), contentFileMap, firstPersonCam);
+                        }
+                        updateProgress(offsets[i]);
+                    }
+                }
+                break;
 
-                    // ignore invalid records
-                    Log(Debug::Warning) << "Warning: Ignoring unknown record: " << n.toStringView();
-                    reader.skipRecord();
-            }
-            int progressPercent = static_cast<int>(float(reader.getFileOffset()) / total * 100);
-            if (progressPercent > currentPercent)
-            {
-                listener.increaseProgress(progressPercent - currentPercent);
-                currentPercent = progressPercent;
+                default:
+                    readRecord(reader, n.toInt(), contentFileMap, firstPersonCam);
             }
+            updateProgress(reader.getFileOffset());
         }
 
         mCharacterManager.setCurrentCharacter(character);
@@ -597,6 +581,88 @@ void MWState::StateManager::loadGame(const Character* character, const std::file
     }
 }
 
+void MWState::StateManager::readRecord(
+    ESM::ESMReader& reader, uint32_t type, const std::map<int, int>& contentFileMap, bool& firstPersonCam)
+{
+    switch (type)
+    {
+        case ESM::REC_JOUR:
+        case ESM::REC_JOUR_LEGACY:
+        case ESM::REC_QUES:
+
+            MWBase::Environment::get().getJournal()->readRecord(reader, type);
+            break;
+
+        case ESM::REC_DIAS:
+
+            MWBase::Environment::get().getDialogueManager()->readRecord(reader, type);
+            break;
+
+        case ESM::REC_ALCH:
+        case ESM::REC_ARMO:
+        case ESM::REC_BOOK:
+        case ESM::REC_CLAS:
+        case ESM::REC_CLOT:
+        case ESM::REC_ENCH:
+        case ESM::REC_NPC_:
+        case ESM::REC_SPEL:
+        case ESM::REC_WEAP:
+        case ESM::REC_GLOB:
+        case ESM::REC_PLAY:
+        case ESM::REC_CSTA:
+        case ESM::REC_WTHR:
+        case ESM::REC_DYNA:
+        case ESM::REC_ACTC:
+        case ESM::REC_PROJ:
+        case ESM::REC_MPRJ:
+        case ESM::REC_ENAB:
+        case ESM::REC_LEVC:
+        case ESM::REC_LEVI:
+        case ESM::REC_CREA:
+        case ESM::REC_CONT:
+        case ESM::REC_RAND:
+            MWBase::Environment::get().getWorld()->readRecord(reader, type, contentFileMap);
+            break;
+
+        case ESM::REC_CAM_:
+            reader.getHNT(firstPersonCam, "FIRS");
+            break;
+
+        case ESM::REC_GSCR:
+
+            MWBase::Environment::get().getScriptManager()->getGlobalScripts().readRecord(reader, type, contentFileMap);
+            break;
+
+        case ESM::REC_GMAP:
+        case ESM::REC_KEYS:
+        case ESM::REC_ASPL:
+        case ESM::REC_MARK:
+
+            MWBase::Environment::get().getWindowManager()->readRecord(reader, type);
+            break;
+
+        case ESM::REC_DCOU:
+        case ESM::REC_STLN:
+
+            MWBase::Environment::get().getMechanicsManager()->readRecord(reader, type);
+            break;
+
+        case ESM::REC_INPU:
+            MWBase::Environment::get().getInputManager()->readRecord(reader, type);
+            break;
+
+        case ESM::REC_LUAM:
+            MWBase::Environment::get().getLuaManager()->readRecord(reader, type);
+            break;
+
+        default:
+
+            // ignore invalid records
+            Log(Debug::Warning) << "Warning: Ignoring unknown record: " << ESM::NAME(type).toStringView();
+            reader.skipRecord();
+    }
+}
+
 void MWState::StateManager::quickLoad()
 {
     if (Character* currentCharacter = getCurrentCharacter())
@@ -609,6 +675,7 @@ void MWState::StateManager::quickLoad()
 
 void MWState::StateManager::deleteGame(const MWState::Character* character, const MWState::Slot* slot)
 {
+    mSaveWriter.wait();
     mCharacterManager.deleteSlot(character, slot);
 }
 
@@ -631,6 +698,9 @@ void MWState::StateManager::update(float duration)
 {
     mTimePlayed += duration;
 
+    for (const AsyncSaveWriter::Failure& failure : mSaveWriter.takeFailures())
+        reportFailedSave(failure.mMessage, failure.mPath);
+
     // Note: It would be nicer to trigger this from InputManager, i.e. the very beginning of the frame update.
     if (mAskLoadRecent)
     {
@@ -6,6 +6,7 @@
 
 #include "../mwbase/statemanager.hpp"
 
+#include "asyncsavewriter.hpp"
 #include "charactermanager.hpp"
 
 namespace MWState
@@ -17,16 +18,22 @@ namespace MWState
         State mState;
         CharacterManager mCharacterManager;
         double mTimePlayed;
+        AsyncSaveWriter mSaveWriter;
 
     private:
         void cleanup(bool force = false);
 
+        void reportFailedSave(const std::string& message, const std::filesystem::path& path);
+
         bool verifyProfile(const ESM::SavedGame& profile) const;
 
         void writeScreenshot(std::vector<char>& imageData) const;
 
         std::map<int, int> buildContentFileIndexMap(const ESM::ESMReader& reader) const;
 
+        void readRecord(
+            ESM::ESMReader& reader, uint32_t type, const std::map<int, int>& contentFileMap, bool& firstPersonCam);
+
     public:
         StateManager(const std::filesystem::path& saves, const std::vector<std::string>& contentFiles);
 
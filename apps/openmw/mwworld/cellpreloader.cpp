@@ -2,9 +2,13 @@
 
 #include <atomic>
 #include <limits>
+#include <optional>
+
+#include <osg/Stats>
 
 #include <components/debug/debuglog.hpp>
 #include <components/esm3/loadcell.hpp>
+#include <components/esm3/readerscache.hpp>
 #include <components/loadinglistener/reporter.hpp>
 #include <components/misc/resourcehelpers.hpp>
 #include <components/misc/strings/lower.hpp>
@@ -14,6 +18,7 @@
 #include <components/resource/scenemanager.hpp>
 #include <components/terrain/view.hpp>
 #include <components/terrain/world.hpp>
+#include <components/to_utf8/to_utf8.hpp>
 #include <components/vfs/manager.hpp>
 
 #include "../mwrender/landmanager.hpp"
@@ -168,6 +173,37 @@ namespace MWWorld
         std::set<osg::ref_ptr<const osg::Object>> mPreloadedObjects;
     };
 
+    /// Worker thread item: read references of an unloaded cell from content files.
+    class ReadRefsItem : public SceneUtil::WorkItem
+    {
+    public:
+        /// Constructor to be called from the main thread.
+        ReadRefsItem(const ESM::Cell& cell, const ToUTF8::Utf8Encoder* encoder)
+            : mCell(cell)
+        {
+            if (encoder != nullptr)
+                mEncoder.emplace(*encoder);
+        }
+
+        void doWork() override
+        {
+            // Readers of the main thread are not thread safe, so the files are opened separately
+            ESM::ReadersCache readers;
+            if (mEncoder.has_value())
+                for (const ESM::ESM_Context& context : mCell.mContextList)
+                    readers.get(static_cast<std::size_t>(context.index))->setEncoder(&*mEncoder);
+            mRefs = CellStore::readContentRefs(mCell, readers);
+        }
+
+        /// To be called from the main thread when the item is done.
+        CellStore::ContentRefs takeRefs() { return std::move(mRefs); }
+
+    private:
+        ESM::Cell mCell;
+        std::optional<ToUTF8::Utf8Encoder> mEncoder;
+        CellStore::ContentRefs mRefs;
+    };
+
     class TerrainPreloadItem : public SceneUtil::WorkItem
     {
     public:
@@ -226,12 +262,16 @@ namespace MWWorld
         , mBulletShapeManager(bulletShapeManager)
         , mTerrain(terrain)
         , mLandManager(landManager)
+        , mEncoder(nullptr)
         , mExpiryDelay(0.0)
         , mMinCacheSize(0)
         , mMaxCacheSize(0)
         , mPreloadInstances(true)
         , mLastResourceCacheUpdate(0.0)
         , mLoadedTerrainTimestamp(0.0)
+        , mHits(0)
+        , mMisses(0)
+        , mWasted(0)
     {
     }
 
@@ -266,17 +306,24 @@ namespace MWWorld
             Log(Debug::Error) << "Error: can't preload, no work queue set";
             return;
         }
-        if (cell->getState() == CellStore::State_Unloaded)
-        {
-            Log(Debug::Error) << "Error: can't preload objects for unloaded cell";
-            return;
-        }
 
         PreloadMap::iterator found = mPreloadCells.find(cell);
         if (found != mPreloadCells.end())
         {
-            // already preloaded, nothing to do other than updating the timestamp
-            found->second.mTimeStamp = timestamp;
+            // already preloaded, nothing to do other than updating the timestamp and continuing with the objects once
+            // the references are read
+            PreloadEntry& entry = found->second;
+            entry.mTimeStamp = timestamp;
+
+            if (entry.mReadRefsItem && entry.mReadRefsItem->isDone())
+            {
+                // the cell may have been loaded by the scene in the meantime
+                if (cell->getState() != CellStore::State_Loaded)
+                    cell->load(entry.mReadRefsItem->takeRefs());
+                entry.mReadRefsItem = nullptr;
+                entry.mWorkItem = createPreloadItem(cell);
+                mWorkQueue->addWorkItem(entry.mWorkItem);
+            }
             return;
         }
 
@@ -299,16 +346,32 @@ namespace MWWorld
             {
                 oldestCell->second.mWorkItem->abort();
                 mPreloadCells.erase(oldestCell);
+                ++mWasted;
             }
             else
                 return;
         }
 
-        osg::ref_ptr<PreloadItem> item(new PreloadItem(cell, mResourceSystem->getSceneManager(), mBulletShapeManager,
-            mResourceSystem->getKeyframeManager(), mTerrain, mLandManager, mPreloadInstances));
+        osg::ref_ptr<ReadRefsItem> readRefsItem;
+        osg::ref_ptr<SceneUtil::WorkItem> item;
+        if (cell->getState() == CellStore::State_Unloaded)
+        {
+            // parsing references doesn't need the main thread, only instantiating them does
+            readRefsItem = new ReadRefsItem(*cell->getCell(), mEncoder);
+            item = readRefsItem;
+        }
+        else
+            item = createPreloadItem(cell);
         mWorkQueue->addWorkItem(item);
 
-        mPreloadCells[cell] = PreloadEntry(timestamp, item);
+        PreloadEntry& entry = mPreloadCells[cell] = PreloadEntry(timestamp, item);
+        entry.mReadRefsItem = readRefsItem;
+    }
+
+    osg::ref_ptr<SceneUtil::WorkItem> CellPreloader::createPreloadItem(CellStore* cell) const
+    {
+        return new PreloadItem(cell, mResourceSystem->getSceneManager(), mBulletShapeManager,
+            mResourceSystem->getKeyframeManager(), mTerrain, mLandManager, mPreloadInstances);
     }
 
     void CellPreloader::notifyLoaded(CellStore* cell)
@@ -323,7 +386,10 @@ namespace MWWorld
             }
 
             mPreloadCells.erase(found);
+            ++mHits;
         }
+        else
+            ++mMisses;
     }
 
     void CellPreloader::clear()
@@ -352,6 +418,7 @@ namespace MWWorld
                     it->second.mWorkItem = nullptr;
                 }
                 mPreloadCells.erase(it++);
+                ++mWasted;
             }
             else
                 ++it;
@@ -403,6 +470,11 @@ namespace MWWorld
         mWorkQueue = workQueue;
     }
 
+    void CellPreloader::setEncoder(const ToUTF8::Utf8Encoder* encoder)
+    {
+        mEncoder = encoder;
+    }
+
     bool CellPreloader::syncTerrainLoad(
         const std::vector<CellPreloader::PositionCellGrid>& positions, double timestamp, Loading::Listener& listener)
     {
@@ -467,4 +539,12 @@ namespace MWWorld
             && contains(mLoadedTerrainPositions, std::array{ position }, ESM::Land::REAL_SIZE);
     }
 
+    void CellPreloader::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        stats.setAttribute(frameNumber, "Preload Cells", mPreloadCells.size());
+        stats.setAttribute(frameNumber, "Preload Hits", mHits);
+        stats.setAttribute(frameNumber, "Preload Misses", mMisses);
+        stats.setAttribute(frameNumber, "Preload Wasted", mWasted);
+    }
+
 }
@@ -7,6 +7,11 @@
 #include <osg/Vec4i>
 #include <osg/ref_ptr>
 
+namespace osg
+{
+    class Stats;
+}
+
 namespace Resource
 {
     class ResourceSystem;
@@ -29,10 +34,16 @@ namespace Loading
     class Listener;
 }
 
+namespace ToUTF8
+{
+    class Utf8Encoder;
+}
+
 namespace MWWorld
 {
     class CellStore;
     class TerrainPreloadItem;
+    class ReadRefsItem;
 
     class CellPreloader
     {
@@ -42,7 +53,8 @@ namespace MWWorld
         ~CellPreloader();
 
         /// Ask a background thread to preload rendering meshes and collision shapes for objects in this cell.
-        /// @note The cell itself must be in State_Loaded or State_Preloaded.
+        /// @note If the cell is in State_Unloaded, its references are read from content files in a background thread
+        /// first. They are added to the cell by one of the following calls for the same cell once ready.
         void preload(MWWorld::CellStore* cell, double timestamp);
 
         void notifyLoaded(MWWorld::CellStore* cell);
@@ -68,6 +80,9 @@ namespace MWWorld
 
         void setWorkQueue(osg::ref_ptr<SceneUtil::WorkQueue> workQueue);
 
+        /// Encoder used to read references of unloaded cells. Each background read uses its own copy.
+        void setEncoder(const ToUTF8::Utf8Encoder* encoder);
+
         typedef std::pair<osg::Vec3f, osg::Vec4i> PositionCellGrid;
         void setTerrainPreloadPositions(const std::vector<PositionCellGrid>& positions);
 
@@ -76,12 +91,17 @@ namespace MWWorld
         void abortTerrainPreloadExcept(const PositionCellGrid* exceptPos);
         bool isTerrainLoaded(const CellPreloader::PositionCellGrid& position, double referenceTime) const;
 
+        /// Report the number of preloaded cells, the number of loaded cells which were (hits) or were not (misses)
+        /// preloaded and the number of preloaded cells thrown out without being loaded (wasted).
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
+
     private:
         Resource::ResourceSystem* mResourceSystem;
         Resource::BulletShapeManager* mBulletShapeManager;
         Terrain::World* mTerrain;
         MWRender::LandManager* mLandManager;
         osg::ref_ptr<SceneUtil::WorkQueue> mWorkQueue;
+        const ToUTF8::Utf8Encoder* mEncoder;
         double mExpiryDelay;
         unsigned int mMinCacheSize;
         unsigned int mMaxCacheSize;
@@ -103,6 +123,8 @@ namespace MWWorld
 
             double mTimeStamp;
             osg::ref_ptr<SceneUtil::WorkItem> mWorkItem;
+            // Set while references of the cell are being read, mWorkItem is the same item then
+            osg::ref_ptr<ReadRefsItem> mReadRefsItem;
         };
         typedef std::map<const MWWorld::CellStore*, PreloadEntry> PreloadMap;
 
@@ -116,6 +138,12 @@ namespace MWWorld
 
         std::vector<PositionCellGrid> mLoadedTerrainPositions;
         double mLoadedTerrainTimestamp;
+
+        std::size_t mHits;
+        std::size_t mMisses;
+        std::size_t mWasted;
+
+        osg::ref_ptr<SceneUtil::WorkItem> createPreloadItem(CellStore* cell) const;
     };
 
 }
@@ -1,7 +1,7 @@
 #ifndef GAME_MWWORLD_CELLREFLIST_H
 #define GAME_MWWORLD_CELLREFLIST_H
 
-#include <list>
+#include <components/misc/chunkedvector.hpp>
 
 #include "livecellref.hpp"
 
@@ -16,7 +16,8 @@ namespace MWWorld
     struct CellRefList : public CellRefListBase
     {
         typedef LiveCellRef<X> LiveRef;
-        typedef std::list<LiveRef> List;
+        // References are pointed to by Ptr, so they must not move when new ones are added
+        typedef Misc::ChunkedVector<LiveRef> List;
         List mList;
 
         /// Search for the given reference in the given reclist from
@@ -35,12 +36,13 @@ namespace MWWorld
         }
 
         /// Remove all references with the given refNum from this list.
+        /// @note Moves following references, so must not be used when there are Ptrs to them.
         void remove(const ESM::RefNum& refNum)
         {
             for (typename List::iterator it = mList.begin(); it != mList.end();)
             {
                 if (*it == refNum)
-                    mList.erase(it++);
+                    it = mList.erase(it);
                 else
                     ++it;
             }
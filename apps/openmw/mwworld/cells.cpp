@@ -133,7 +133,7 @@ MWWorld::Cells::Cells(const MWWorld::ESMStore& store, ESM::ReadersCache& readers
     mIdCache = IdCache(cacheSize, std::pair<std::string, CellStore*>("", (CellStore*)nullptr));
 }
 
-MWWorld::CellStore* MWWorld::Cells::getExterior(int x, int y)
+MWWorld::CellStore* MWWorld::Cells::getExterior(int x, int y, bool load)
 {
     std::map<std::pair<int, int>, CellStore>::iterator result = mExteriors.find(std::make_pair(x, y));
 
@@ -162,7 +162,7 @@ MWWorld::CellStore* MWWorld::Cells::getExterior(int x, int y)
         result = mExteriors.emplace(std::make_pair(x, y), CellStore(cell, mStore, mReaders)).first;
     }
 
-    if (result->second.getState() != CellStore::State_Loaded)
+    if (load && result->second.getState() != CellStore::State_Loaded)
     {
         result->second.load();
     }
@@ -170,7 +170,7 @@ MWWorld::CellStore* MWWorld::Cells::getExterior(int x, int y)
     return &result->second;
 }
 
-MWWorld::CellStore* MWWorld::Cells::getInterior(std::string_view name)
+MWWorld::CellStore* MWWorld::Cells::getInterior(std::string_view name, bool load)
 {
     std::string lowerName = Misc::StringUtils::lowerCase(name);
     std::map<std::string, CellStore>::iterator result = mInteriors.find(lowerName);
@@ -182,7 +182,7 @@ MWWorld::CellStore* MWWorld::Cells::getInterior(std::string_view name)
         result = mInteriors.emplace(std::move(lowerName), CellStore(cell, mStore, mReaders)).first;
     }
 
-    if (result->second.getState() != CellStore::State_Loaded)
+    if (load && result->second.getState() != CellStore::State_Loaded)
     {
         result->second.load();
     }
@@ -53,9 +53,12 @@ namespace MWWorld
 
         explicit Cells(const MWWorld::ESMStore& store, ESM::ReadersCache& reader);
 
-        CellStore* getExterior(int x, int y);
+        CellStore* getExterior(int x, int y, bool load = true);
+        ///< \param load Load references from content files if not loaded yet. Otherwise they may be read in
+        /// background by CellPreloader.
 
-        CellStore* getInterior(std::string_view name);
+        CellStore* getInterior(std::string_view name, bool load = true);
+        ///< \param load See getExterior.
 
         CellStore* getCell(const ESM::CellId& id);
 
@@ -350,7 +350,7 @@ namespace MWWorld
 
         if (const X* ptr = store.search(ref.mRefID))
         {
-            typename std::list<LiveRef>::iterator iter = std::find(mList.begin(), mList.end(), ref.mRefNum);
+            typename List::iterator iter = std::find(mList.begin(), mList.end(), ref.mRefNum);
 
             LiveRef liveCellRef(ref, ptr);
 
@@ -660,6 +660,19 @@ namespace MWWorld
         }
     }
 
+    void CellStore::load(ContentRefs&& refs)
+    {
+        if (mState != State_Loaded)
+        {
+            if (mState == State_Preloaded)
+                mIds.clear();
+
+            loadRefs(std::move(refs));
+
+            mState = State_Loaded;
+        }
+    }
+
     void CellStore::preload()
     {
         if (mState == State_Unloaded)
@@ -729,24 +742,19 @@ namespace MWWorld
         std::sort(mIds.begin(), mIds.end());
     }
 
-    void CellStore::loadRefs()
+    CellStore::ContentRefs CellStore::readContentRefs(const ESM::Cell& cell, ESM::ReadersCache& readers)
     {
-        assert(mCell);
-
-        if (mCell->mContextList.empty())
-            return; // this is a dynamically generated cell -> skipping.
-
-        std::map<ESM::RefNum, std::string> refNumToID; // used to detect refID modifications
+        ContentRefs result;
 
         // Load references from all plugins that do something with this cell.
-        for (size_t i = 0; i < mCell->mContextList.size(); i++)
+        for (size_t i = 0; i < cell.mContextList.size(); i++)
         {
             try
             {
                 // Reopen the ESM reader and seek to the right position.
-                const std::size_t index = static_cast<std::size_t>(mCell->mContextList[i].index);
-                const ESM::ReadersCache::BusyItem reader = mReaders.get(index);
-                mCell->restore(*reader, i);
+                const std::size_t index = static_cast<std::size_t>(cell.mContextList[i].index);
+                const ESM::ReadersCache::BusyItem reader = readers.get(index);
+                cell.restore(*reader, i);
 
                 ESM::CellRef ref;
                 ref.mRefNum.unset();
@@ -764,22 +772,45 @@ namespace MWWorld
 
                     // Don't load reference if it was moved to a different cell.
                     ESM::MovedCellRefTracker::const_iterator iter
-                        = std::find(mCell->mMovedRefs.begin(), mCell->mMovedRefs.end(), ref.mRefNum);
-                    if (iter != mCell->mMovedRefs.end())
+                        = std::find(cell.mMovedRefs.begin(), cell.mMovedRefs.end(), ref.mRefNum);
+                    if (iter != cell.mMovedRefs.end())
                     {
                         continue;
                     }
 
-                    loadRef(ref, deleted, refNumToID);
+                    Misc::StringUtils::lowerCaseInPlace(ref.mRefID);
+                    result.emplace_back(ref, deleted);
                 }
             }
             catch (std::exception& e)
             {
-                Log(Debug::Error) << "An error occurred loading references for cell " << getCell()->getDescription()
-                                  << ": " << e.what();
+                Log(Debug::Error) << "An error occurred loading references for cell " << cell.getDescription() << ": "
+                                  << e.what();
             }
         }
 
+        return result;
+    }
+
+    void CellStore::loadRefs()
+    {
+        assert(mCell);
+
+        loadRefs(readContentRefs(*mCell, mReaders));
+    }
+
+    void CellStore::loadRefs(ContentRefs&& refs)
+    {
+        assert(mCell);
+
+        if (mCell->mContextList.empty())
+            return; // this is a dynamically generated cell -> skipping.
+
+        std::map<ESM::RefNum, std::string> refNumToID; // used to detect refID modifications
+
+        for (auto& [ref, deleted] : refs)
+            loadRef(ref, deleted, refNumToID);
+
         // Load moved references, from separately tracked list.
         for (const auto& leasedRef : mCell->mLeasedRefs)
         {
@@ -9,6 +9,7 @@
 #include <string_view>
 #include <tuple>
 #include <typeinfo>
+#include <utility>
 #include <vector>
 
 #include "cellreflist.hpp"
@@ -234,6 +235,16 @@ namespace MWWorld
         void load();
         ///< Load references from content file.
 
+        /// References read from content files paired with their deleted flag.
+        using ContentRefs = std::vector<std::pair<ESM::CellRef, bool>>;
+
+        static ContentRefs readContentRefs(const ESM::Cell& cell, ESM::ReadersCache& readers);
+        ///< Read references of \a cell from content files. Doesn't access any other state, so it can be done in a
+        /// background thread with its own \a readers.
+
+        void load(ContentRefs&& refs);
+        ///< Load references previously read by readContentRefs.
+
         void preload();
         ///< Build ID list from content file.
 
@@ -371,6 +382,8 @@ namespace MWWorld
 
         void loadRefs();
 
+        void loadRefs(ContentRefs&& refs);
+
         void loadRef(ESM::CellRef& ref, bool deleted, std::map<ESM::RefNum, std::string>& refNumToID);
         ///< Make case-adjustments to \a ref and insert it into the respective container.
         ///
@@ -243,6 +243,56 @@ namespace
         }
     }
 
+    // Objects within this distance from the player are inserted in the same frame their cell is loaded
+    constexpr float immediateInsertionDistance = Constants::CellSizeInUnits / 4;
+
+    bool shouldInsertImmediately(const MWWorld::Ptr& ptr, const osg::Vec3f& position)
+    {
+        // Actors, doors and scripted objects are needed by AI and scripts right away. Levelled lists spawn actors.
+        if (ptr.getClass().isActor() || ptr.getClass().isDoor() || ptr.getType() == ESM::REC_LEVC
+            || !ptr.getClass().getScript(ptr).empty())
+            return true;
+        return (ptr.getRefData().getPosition().asVec3() - position).length2()
+            < immediateInsertionDistance * immediateInsertionDistance;
+    }
+
+    float getInsertionPriority(const MWWorld::Ptr& ptr, const osg::Vec3f& position)
+    {
+        const float distance2 = (ptr.getRefData().getPosition().asVec3() - position).length2();
+        switch (ptr.getType())
+        {
+            case ESM::REC_STAT:
+            case ESM::REC_CONT:
+            case ESM::REC_ACTI:
+                return distance2;
+        }
+        // Items and lights hardly affect collisions, so they are inserted as if they were twice as far
+        return 4 * distance2;
+    }
+
+    // Time over which the player velocity is averaged to predict where the player goes
+    constexpr float velocitySmoothingTime = 0.5f;
+
+    // Maximum number of cells remembered as recently visited by the player
+    constexpr std::size_t maxRecentCells = 8;
+
+    // Likelihood of the player reaching a preload candidate at the given position: the closer the better, more if the
+    // player is heading there
+    float getPreloadScore(const osg::Vec3f& position, const osg::Vec3f& playerPos, const osg::Vec3f& predictedPos,
+        const osg::Vec3f& velocity, float maxDistance)
+    {
+        const float distance = std::min((position - playerPos).length(), (position - predictedPos).length());
+        float score = std::max(0.f, 1 - distance / maxDistance);
+        osg::Vec3f direction = position - playerPos;
+        if (direction.normalize() > 0 && velocity.length2() > 0)
+        {
+            osg::Vec3f heading = velocity;
+            heading.normalize();
+            score += 0.5f * std::max(0.f, direction * heading);
+        }
+        return score;
+    }
+
     int getCellPositionDistanceToOrigin(const std::pair<int, int>& cellPosition)
     {
         return std::abs(cellPosition.first) + std::abs(cellPosition.second);
@@ -307,9 +357,11 @@ namespace MWWorld
         if (mChangeCellGridRequest.has_value())
         {
             changeCellGrid(mChangeCellGridRequest->mPosition, mChangeCellGridRequest->mCell.x(),
-                mChangeCellGridRequest->mCell.y(), mChangeCellGridRequest->mChangeEvent);
+                mChangeCellGridRequest->mCell.y(), mChangeCellGridRequest->mChangeEvent, true);
             mChangeCellGridRequest.reset();
         }
+        else // loading cells took long enough for this frame
+            insertPendingObjects();
 
         mPreloader->updateCache(mRendering.getReferenceTime());
         preloadCells(duration);
@@ -322,6 +374,10 @@ namespace MWWorld
 
         Log(Debug::Info) << "Unloading cell " << cell->getCell()->getDescription();
 
+        const auto isInCell = [&](const PendingObject& object) { return object.mCell == cell; };
+        mPendingObjects.erase(
+            std::remove_if(mPendingObjects.begin(), mPendingObjects.end(), isInCell), mPendingObjects.end());
+
         ListAndResetObjectsVisitor visitor;
 
         cell->forEach(visitor);
@@ -375,7 +431,7 @@ namespace MWWorld
     }
 
     void Scene::loadCell(CellStore* cell, Loading::Listener* loadingListener, bool respawn, const osg::Vec3f& position,
-        const DetourNavigator::UpdateGuard* navigatorUpdateGuard)
+        const DetourNavigator::UpdateGuard* navigatorUpdateGuard, bool deferInsertion)
     {
         using DetourNavigator::HeightfieldShape;
 
@@ -439,7 +495,7 @@ namespace MWWorld
         if (respawn)
             cell->respawn();
 
-        insertCell(*cell, loadingListener, navigatorUpdateGuard);
+        insertCell(*cell, loadingListener, navigatorUpdateGuard, deferInsertion ? &position : nullptr);
 
         mRendering.addCell(cell);
 
@@ -484,6 +540,7 @@ namespace MWWorld
         navigatorUpdateGuard.reset();
         assert(mActiveCells.empty());
         mCurrentCell = nullptr;
+        mRecentCells.clear();
 
         mPreloader->clear();
     }
@@ -524,7 +581,8 @@ namespace MWWorld
         mChangeCellGridRequest = ChangeCellGridRequest{ position, cell, changeEvent };
     }
 
-    void Scene::changeCellGrid(const osg::Vec3f& pos, int playerCellX, int playerCellY, bool changeEvent)
+    void Scene::changeCellGrid(
+        const osg::Vec3f& pos, int playerCellX, int playerCellY, bool changeEvent, bool deferInsertion)
     {
         auto navigatorUpdateGuard = mNavigator.makeUpdateGuard();
 
@@ -603,7 +661,8 @@ namespace MWWorld
             if (!isCellInCollection(x, y, mActiveCells))
             {
                 CellStore* cell = mWorld.getWorldModel().getExterior(x, y);
-                loadCell(cell, loadingListener, changeEvent, pos, navigatorUpdateGuard.get());
+                loadCell(cell, loadingListener, changeEvent, pos, navigatorUpdateGuard.get(),
+                    deferInsertion && mInsertionTimeBudget > std::chrono::steady_clock::duration::zero());
             }
         }
 
@@ -669,7 +728,7 @@ namespace MWWorld
             const osg::Vec3f position
                 = osg::Vec3f(it->mData.mX + 0.5f, it->mData.mY + 0.5f, 0) * Constants::CellSizeInUnits;
             mNavigator.updateBounds(position, navigatorUpdateGuard.get());
-            loadCell(cell, nullptr, false, position, navigatorUpdateGuard.get());
+            loadCell(cell, nullptr, false, position, navigatorUpdateGuard.get(), false);
 
             mNavigator.update(position, navigatorUpdateGuard.get());
             navigatorUpdateGuard.reset();
@@ -726,7 +785,7 @@ namespace MWWorld
             ESM::Position position;
             mWorld.findInteriorPosition(it->mName, position);
             mNavigator.updateBounds(position.asVec3(), navigatorUpdateGuard.get());
-            loadCell(cell, nullptr, false, position.asVec3(), navigatorUpdateGuard.get());
+            loadCell(cell, nullptr, false, position.asVec3(), navigatorUpdateGuard.get(), false);
 
             mNavigator.update(position.asVec3(), navigatorUpdateGuard.get());
             navigatorUpdateGuard.reset();
@@ -762,6 +821,11 @@ namespace MWWorld
     {
         mCurrentCell = cell;
 
+        mRecentCells.erase(std::remove(mRecentCells.begin(), mRecentCells.end(), cell), mRecentCells.end());
+        mRecentCells.push_front(cell);
+        if (mRecentCells.size() > maxRecentCells)
+            mRecentCells.pop_back();
+
         mRendering.enableTerrain(cell->isExterior());
 
         MWWorld::Ptr old = mWorld.getPlayerPtr();
@@ -791,10 +855,11 @@ namespace MWWorld
         mWorld.adjustSky();
 
         mLastPlayerPos = player.getRefData().getPosition().asVec3();
+        mPlayerVelocity = osg::Vec3f();
     }
 
     Scene::Scene(MWWorld::World& world, MWRender::RenderingManager& rendering, MWPhysics::PhysicsSystem* physics,
-        DetourNavigator::Navigator& navigator)
+        DetourNavigator::Navigator& navigator, const ToUTF8::Utf8Encoder* encoder)
         : mCurrentCell(nullptr)
         , mCellChanged(false)
         , mWorld(world)
@@ -808,10 +873,13 @@ namespace MWWorld
         , mPreloadDoors(Settings::Manager::getBool("preload doors", "Cells"))
         , mPreloadFastTravel(Settings::Manager::getBool("preload fast travel", "Cells"))
         , mPredictionTime(Settings::Manager::getFloat("prediction time", "Cells"))
+        , mInsertionTimeBudget(std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+              std::chrono::duration<float, std::milli>(Settings::Manager::getFloat("insertion time budget", "Cells"))))
     {
         mPreloader = std::make_unique<CellPreloader>(rendering.getResourceSystem(), physics->getShapeManager(),
             rendering.getTerrain(), rendering.getLandManager());
         mPreloader->setWorkQueue(mRendering.getWorkQueue());
+        mPreloader->setEncoder(encoder);
 
         rendering.getResourceSystem()->setExpiryDelay(Settings::Manager::getFloat("cache expiry delay", "Cells"));
 
@@ -883,7 +951,7 @@ namespace MWWorld
 
         // Load cell.
         mPagedRefs.clear();
-        loadCell(cell, loadingListener, changeEvent, position.asVec3(), navigatorUpdateGuard.get());
+        loadCell(cell, loadingListener, changeEvent, position.asVec3(), navigatorUpdateGuard.get(), false);
 
         navigatorUpdateGuard.reset();
 
@@ -937,17 +1005,58 @@ namespace MWWorld
         mCellChanged = false;
     }
 
-    void Scene::insertCell(
-        CellStore& cell, Loading::Listener* loadingListener, const DetourNavigator::UpdateGuard* navigatorUpdateGuard)
+    void Scene::insertCell(CellStore& cell, Loading::Listener* loadingListener,
+        const DetourNavigator::UpdateGuard* navigatorUpdateGuard, const osg::Vec3f* deferFrom)
     {
         InsertVisitor insertVisitor(cell, loadingListener);
         cell.forEach(insertVisitor);
+        if (deferFrom != nullptr)
+        {
+            const auto deferred = std::stable_partition(insertVisitor.mToInsert.begin(), insertVisitor.mToInsert.end(),
+                [&](const MWWorld::Ptr& ptr) { return shouldInsertImmediately(ptr, *deferFrom); });
+            for (auto it = deferred; it != insertVisitor.mToInsert.end(); ++it)
+                mPendingObjects.push_back(PendingObject{ &cell, *it, getInsertionPriority(*it, *deferFrom) });
+            if (loadingListener != nullptr)
+                loadingListener->increaseProgress(
+                    2 * static_cast<std::size_t>(insertVisitor.mToInsert.end() - deferred));
+            insertVisitor.mToInsert.erase(deferred, insertVisitor.mToInsert.end());
+            std::sort(mPendingObjects.begin(), mPendingObjects.end(),
+                [](const PendingObject& lhs, const PendingObject& rhs) { return lhs.mPriority > rhs.mPriority; });
+        }
         insertVisitor.insert(
             [&](const MWWorld::Ptr& ptr) { addObject(ptr, mWorld, mPagedRefs, *mPhysics, mRendering); });
         insertVisitor.insert(
             [&](const MWWorld::Ptr& ptr) { addObject(ptr, mWorld, *mPhysics, mNavigator, navigatorUpdateGuard); });
     }
 
+    void Scene::insertPendingObjects()
+    {
+        if (mPendingObjects.empty())
+            return;
+
+        const auto start = std::chrono::steady_clock::now();
+        auto navigatorUpdateGuard = mNavigator.makeUpdateGuard();
+        do
+        {
+            const Ptr ptr = mPendingObjects.back().mPtr;
+            mPendingObjects.pop_back();
+
+            // The object could be deleted, disabled or already inserted by a script in the meantime
+            if (ptr.getRefData().isDeleted() || !ptr.getRefData().isEnabled() || ptr.getRefData().getBaseNode())
+                continue;
+
+            try
+            {
+                addObject(ptr, mWorld, mPagedRefs, *mPhysics, mRendering);
+                addObject(ptr, mWorld, *mPhysics, mNavigator, navigatorUpdateGuard.get());
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Error) << "failed to render '" << ptr.getCellRef().getRefId() << "': " << e.what();
+            }
+        } while (!mPendingObjects.empty() && std::chrono::steady_clock::now() - start < mInsertionTimeBudget);
+    }
+
     void Scene::addObjectToScene(const Ptr& ptr)
     {
         try
@@ -964,6 +1073,12 @@ namespace MWWorld
 
     void Scene::removeObjectFromScene(const Ptr& ptr, bool keepActive)
     {
+        // Deferred insertion must not bring back the object, e.g. when it is moved to an inactive cell
+        const auto pending = std::find_if(mPendingObjects.begin(), mPendingObjects.end(),
+            [&](const PendingObject& object) { return object.mPtr.mRef == ptr.mRef; });
+        if (pending != mPendingObjects.end())
+            mPendingObjects.erase(pending);
+
         MWBase::Environment::get().getMechanicsManager()->remove(ptr, keepActive);
         // You'd expect the sounds attached to the object to be stopped here
         // because the object is nowhere to be heard, but in Morrowind, they're not.
@@ -987,6 +1102,17 @@ namespace MWWorld
         ptr.getRefData().setBaseNode(nullptr);
     }
 
+    void Scene::insertPendingObject(const Ptr& ptr)
+    {
+        const auto it = std::find_if(mPendingObjects.begin(), mPendingObjects.end(),
+            [&](const PendingObject& object) { return object.mPtr.mRef == ptr.mRef; });
+        if (it == mPendingObjects.end())
+            return;
+        mPendingObjects.erase(it);
+        if (!ptr.getRefData().isDeleted() && ptr.getRefData().isEnabled())
+            addObjectToScene(ptr);
+    }
+
     bool Scene::isCellActive(const CellStore& cell)
     {
         CellStoreCollection::iterator active = mActiveCells.begin();
@@ -1001,6 +1127,11 @@ namespace MWWorld
         return false;
     }
 
+    void Scene::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        mPreloader->reportStats(frameNumber, stats);
+    }
+
     Ptr Scene::searchPtrViaActorId(int actorId)
     {
         for (CellStoreCollection::const_iterator iter(mActiveCells.begin()); iter != mActiveCells.end(); ++iter)
@@ -1067,7 +1198,9 @@ namespace MWWorld
         const MWWorld::ConstPtr player = mWorld.getPlayerPtr();
         osg::Vec3f playerPos = player.getRefData().getPosition().asVec3();
         osg::Vec3f moved = playerPos - mLastPlayerPos;
-        osg::Vec3f predictedPos = playerPos + moved / dt * mPredictionTime;
+        const float smoothing = std::min(1.f, dt / velocitySmoothingTime);
+        mPlayerVelocity = mPlayerVelocity * (1 - smoothing) + moved / dt * smoothing;
+        osg::Vec3f predictedPos = playerPos + mPlayerVelocity * mPredictionTime;
 
         if (mCurrentCell->isExterior())
             exteriorPositions.emplace_back(
@@ -1077,19 +1210,53 @@ namespace MWWorld
 
         if (mPreloadEnabled)
         {
+            std::vector<PreloadCandidate> candidates;
             if (mPreloadDoors)
-                preloadTeleportDoorDestinations(playerPos, predictedPos, exteriorPositions);
+                preloadTeleportDoorDestinations(playerPos, predictedPos, exteriorPositions, candidates);
             if (mPreloadExteriorGrid)
-                preloadExteriorGrid(playerPos, predictedPos);
+                preloadExteriorGrid(playerPos, predictedPos, candidates);
             if (mPreloadFastTravel)
-                preloadFastTravelDestinations(playerPos, predictedPos, exteriorPositions);
+                preloadFastTravelDestinations(playerPos, predictedPos, exteriorPositions, candidates);
+            preloadCandidates(candidates);
         }
 
         mPreloader->setTerrainPreloadPositions(exteriorPositions);
     }
 
-    void Scene::preloadTeleportDoorDestinations(
-        const osg::Vec3f& playerPos, const osg::Vec3f& predictedPos, std::vector<PositionCellGrid>& exteriorPositions)
+    float Scene::getPreloadHistoryScore(const CellStore* cell) const
+    {
+        // Players often go back to where they came from
+        if (std::find(mRecentCells.begin(), mRecentCells.end(), cell) != mRecentCells.end())
+            return 0.5f;
+        return 0;
+    }
+
+    void Scene::preloadCandidates(std::vector<PreloadCandidate>& candidates)
+    {
+        // Request the most likely destinations first and only as many as fit into the cache, so unlikely ones don't
+        // replace them
+        std::stable_sort(candidates.begin(), candidates.end(),
+            [](const PreloadCandidate& lhs, const PreloadCandidate& rhs) { return lhs.mScore > rhs.mScore; });
+
+        const std::size_t surroundingCells = (2 * mHalfGridSize + 1) * (2 * mHalfGridSize + 1);
+        std::size_t budget = mPreloader->getMaxCacheSize();
+        std::vector<const CellStore*> requested;
+        for (const PreloadCandidate& candidate : candidates)
+        {
+            if (budget == 0)
+                break;
+            if (std::find(requested.begin(), requested.end(), candidate.mCell) != requested.end())
+                continue;
+            requested.push_back(candidate.mCell);
+            const bool surrounding = candidate.mPreloadSurrounding && candidate.mCell->isExterior();
+            const std::size_t cells = surrounding ? surroundingCells : 1;
+            preloadCell(candidate.mCell, candidate.mPreloadSurrounding);
+            budget -= std::min(budget, cells);
+        }
+    }
+
+    void Scene::preloadTeleportDoorDestinations(const osg::Vec3f& playerPos, const osg::Vec3f& predictedPos,
+        std::vector<PositionCellGrid>& exteriorPositions, std::vector<PreloadCandidate>& candidates)
     {
         std::vector<MWWorld::ConstPtr> teleportDoors;
         for (const MWWorld::CellStore* cellStore : mActiveCells)
@@ -1116,13 +1283,19 @@ namespace MWWorld
             {
                 try
                 {
+                    const float score = getPreloadScore(door.getRefData().getPosition().asVec3(), playerPos,
+                        predictedPos, mPlayerVelocity, mPreloadDistance);
                     if (!door.getCellRef().getDestCell().empty())
-                        preloadCell(mWorld.getWorldModel().getInterior(door.getCellRef().getDestCell()));
+                    {
+                        CellStore* cell = mWorld.getWorldModel().getInterior(door.getCellRef().getDestCell(), false);
+                        candidates.push_back(PreloadCandidate{ cell, false, score + getPreloadHistoryScore(cell) });
+                    }
                     else
                     {
                         osg::Vec3f pos = door.getCellRef().getDoorDest().asVec3();
                         const osg::Vec2i cellIndex = positionToCellIndex(pos.x(), pos.y());
-                        preloadCell(mWorld.getWorldModel().getExterior(cellIndex.x(), cellIndex.y()), true);
+                        CellStore* cell = mWorld.getWorldModel().getExterior(cellIndex.x(), cellIndex.y(), false);
+                        candidates.push_back(PreloadCandidate{ cell, true, score + getPreloadHistoryScore(cell) });
                         exteriorPositions.emplace_back(pos, gridCenterToBounds(getNewGridCenter(pos)));
                     }
                 }
@@ -1134,7 +1307,8 @@ namespace MWWorld
         }
     }
 
-    void Scene::preloadExteriorGrid(const osg::Vec3f& playerPos, const osg::Vec3f& predictedPos)
+    void Scene::preloadExteriorGrid(
+        const osg::Vec3f& playerPos, const osg::Vec3f& predictedPos, std::vector<PreloadCandidate>& candidates)
     {
         if (!mWorld.isCellExterior())
             return;
@@ -1168,7 +1342,12 @@ namespace MWWorld
                     + mPreloadDistance;
 
                 if (dist < loadDist)
-                    preloadCell(mWorld.getWorldModel().getExterior(cellX + dx, cellY + dy));
+                {
+                    CellStore* cell = mWorld.getWorldModel().getExterior(cellX + dx, cellY + dy, false);
+                    const osg::Vec3f center(thisCellCenterX, thisCellCenterY, playerPos.z());
+                    const float score = getPreloadScore(center, playerPos, predictedPos, mPlayerVelocity, loadDist);
+                    candidates.push_back(PreloadCandidate{ cell, false, score + getPreloadHistoryScore(cell) });
+                }
             }
         }
     }
@@ -1185,7 +1364,7 @@ namespace MWWorld
                 for (int dy = -mHalfGridSize; dy <= mHalfGridSize; ++dy)
                 {
                     mPreloader->preload(
-                        mWorld.getWorldModel().getExterior(x + dx, y + dy), mRendering.getReferenceTime());
+                        mWorld.getWorldModel().getExterior(x + dx, y + dy, false), mRendering.getReferenceTime());
                     if (++numpreloaded >= mPreloader->getMaxCacheSize())
                         break;
                 }
@@ -1250,9 +1429,9 @@ namespace MWWorld
     };
 
     void Scene::preloadFastTravelDestinations(const osg::Vec3f& playerPos, const osg::Vec3f& /*predictedPos*/,
-        std::vector<PositionCellGrid>&
-            exteriorPositions) // ignore predictedPos here since opening dialogue with travel service takes extra time
+        std::vector<PositionCellGrid>& exteriorPositions, std::vector<PreloadCandidate>& candidates)
     {
+        // ignore predictedPos here since opening dialogue with travel service takes extra time
         const MWWorld::ConstPtr player = mWorld.getPlayerPtr();
         ListFastTravelDestinationsVisitor listVisitor(mPreloadDistance, player.getRefData().getPosition().asVec3());
 
@@ -1262,15 +1441,21 @@ namespace MWWorld
             cellStore->forEachType<ESM::Creature>(listVisitor);
         }
 
+        // Any of the destinations may be chosen only after talking to the service, so they are less likely than
+        // anything the player can reach by walking
         for (ESM::Transport::Dest& dest : listVisitor.mList)
         {
             if (!dest.mCellName.empty())
-                preloadCell(mWorld.getWorldModel().getInterior(dest.mCellName));
+            {
+                CellStore* cell = mWorld.getWorldModel().getInterior(dest.mCellName, false);
+                candidates.push_back(PreloadCandidate{ cell, false, getPreloadHistoryScore(cell) });
+            }
             else
             {
                 osg::Vec3f pos = dest.mPos.asVec3();
                 const osg::Vec2i cellIndex = positionToCellIndex(pos.x(), pos.y());
-                preloadCell(mWorld.getWorldModel().getExterior(cellIndex.x(), cellIndex.y()), true);
+                CellStore* cell = mWorld.getWorldModel().getExterior(cellIndex.x(), cellIndex.y(), false);
+                candidates.push_back(PreloadCandidate{ cell, true, getPreloadHistoryScore(cell) });
                 exteriorPositions.emplace_back(pos, gridCenterToBounds(getNewGridCenter(pos)));
             }
         }
@@ -7,6 +7,8 @@
 
 #include "ptr.hpp"
 
+#include <chrono>
+#include <deque>
 #include <memory>
 #include <optional>
 #include <set>
@@ -18,6 +20,7 @@
 namespace osg
 {
     class Vec3f;
+    class Stats;
 }
 
 namespace ESM
@@ -57,6 +60,11 @@ namespace SceneUtil
     class WorkItem;
 }
 
+namespace ToUTF8
+{
+    class Utf8Encoder;
+}
+
 namespace MWWorld
 {
     class Player;
@@ -83,6 +91,20 @@ namespace MWWorld
             bool mChangeEvent;
         };
 
+        struct PendingObject
+        {
+            CellStore* mCell;
+            Ptr mPtr;
+            float mPriority;
+        };
+
+        struct PreloadCandidate
+        {
+            CellStore* mCell;
+            bool mPreloadSurrounding;
+            float mScore;
+        };
+
         CellStore* mCurrentCell; // the cell the player is in
         CellStoreCollection mActiveCells;
         bool mCellChanged;
@@ -100,10 +122,15 @@ namespace MWWorld
         bool mPreloadDoors;
         bool mPreloadFastTravel;
         float mPredictionTime;
+        std::chrono::steady_clock::duration mInsertionTimeBudget;
 
         static const int mHalfGridSize = Constants::CellGridRadius;
 
         osg::Vec3f mLastPlayerPos;
+        osg::Vec3f mPlayerVelocity;
+
+        // Cells the player has been in, the most recent first
+        std::deque<const CellStore*> mRecentCells;
 
         std::vector<ESM::RefNum> mPagedRefs;
 
@@ -111,13 +138,22 @@ namespace MWWorld
 
         std::optional<ChangeCellGridRequest> mChangeCellGridRequest;
 
+        // Objects of active cells not inserted into the scene yet, the one with the highest priority is at the back
+        std::vector<PendingObject> mPendingObjects;
+
+        /// @param deferFrom If set, only objects near this position or required by actors and scripts are inserted
+        /// right away. The rest is inserted by insertPendingObjects in the following frames.
         void insertCell(CellStore& cell, Loading::Listener* loadingListener,
-            const DetourNavigator::UpdateGuard* navigatorUpdateGuard);
+            const DetourNavigator::UpdateGuard* navigatorUpdateGuard, const osg::Vec3f* deferFrom = nullptr);
+
+        /// Insert pending objects into the scene until the time budget for this frame is spent.
+        void insertPendingObjects();
 
         osg::Vec2i mCurrentGridCenter;
 
         // Load and unload cells as necessary to create a cell grid with "X" and "Y" in the center
-        void changeCellGrid(const osg::Vec3f& pos, int playerCellX, int playerCellY, bool changeEvent = true);
+        void changeCellGrid(const osg::Vec3f& pos, int playerCellX, int playerCellY, bool changeEvent = true,
+            bool deferInsertion = false);
 
         void requestChangeCellGrid(const osg::Vec3f& position, const osg::Vec2i& cell, bool changeEvent = true);
 
@@ -125,21 +161,24 @@ namespace MWWorld
 
         void preloadCells(float dt);
         void preloadTeleportDoorDestinations(const osg::Vec3f& playerPos, const osg::Vec3f& predictedPos,
-            std::vector<PositionCellGrid>& exteriorPositions);
-        void preloadExteriorGrid(const osg::Vec3f& playerPos, const osg::Vec3f& predictedPos);
+            std::vector<PositionCellGrid>& exteriorPositions, std::vector<PreloadCandidate>& candidates);
+        void preloadExteriorGrid(
+            const osg::Vec3f& playerPos, const osg::Vec3f& predictedPos, std::vector<PreloadCandidate>& candidates);
         void preloadFastTravelDestinations(const osg::Vec3f& playerPos, const osg::Vec3f& predictedPos,
-            std::vector<PositionCellGrid>& exteriorPositions);
+            std::vector<PositionCellGrid>& exteriorPositions, std::vector<PreloadCandidate>& candidates);
+        float getPreloadHistoryScore(const CellStore* cell) const;
+        void preloadCandidates(std::vector<PreloadCandidate>& candidates);
 
         osg::Vec4i gridCenterToBounds(const osg::Vec2i& centerCell) const;
         osg::Vec2i getNewGridCenter(const osg::Vec3f& pos, const osg::Vec2i* currentGridCenter = nullptr) const;
 
         void unloadCell(CellStore* cell, const DetourNavigator::UpdateGuard* navigatorUpdateGuard);
         void loadCell(CellStore* cell, Loading::Listener* loadingListener, bool respawn, const osg::Vec3f& position,
-            const DetourNavigator::UpdateGuard* navigatorUpdateGuard);
+            const DetourNavigator::UpdateGuard* navigatorUpdateGuard, bool deferInsertion);
 
     public:
         Scene(MWWorld::World& world, MWRender::RenderingManager& rendering, MWPhysics::PhysicsSystem* physics,
-            DetourNavigator::Navigator& navigator);
+            DetourNavigator::Navigator& navigator, const ToUTF8::Utf8Encoder* encoder);
 
         ~Scene();
 
@@ -184,6 +223,10 @@ namespace MWWorld
         void removeObjectFromScene(const Ptr& ptr, bool keepActive = false);
         ///< Remove an object from the scene, but not from the world model.
 
+        void insertPendingObject(const Ptr& ptr);
+        ///< Add an object to the scene right away if its insertion was deferred, e.g. before it is moved to another
+        /// cell.
+
         void addPostponedPhysicsObjects();
 
         void removeFromPagedRefs(const Ptr& ptr);
@@ -195,6 +238,8 @@ namespace MWWorld
 
         Ptr searchPtrViaActorId(int actorId);
 
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
+
         void preload(const std::string& mesh, bool useAnim = false);
 
         void testExteriorCells();
@@ -40,6 +40,7 @@
 #include <components/sceneutil/workqueue.hpp>
 
 #include <components/detournavigator/agentbounds.hpp>
+#include <components/detournavigator/asyncpathfinder.hpp>
 #include <components/detournavigator/navigator.hpp>
 #include <components/detournavigator/navigatorimpl.hpp>
 #include <components/detournavigator/settings.hpp>
@@ -207,6 +208,8 @@ namespace MWWorld
             auto navigatorSettings = DetourNavigator::makeSettingsFromSettingsManager();
             navigatorSettings.mRecast.mSwimHeightScale = mSwimHeightScale;
             mNavigator = DetourNavigator::makeNavigator(navigatorSettings, userDataPath);
+            if (navigatorSettings.mAsyncPathFinderThreads > 0)
+                mAsyncPathFinder = std::make_unique<DetourNavigator::AsyncPathFinder>(*mNavigator);
         }
         else
         {
@@ -221,7 +224,7 @@ namespace MWWorld
 
         mWeatherManager = std::make_unique<MWWorld::WeatherManager>(*mRendering, mStore);
 
-        mWorldScene = std::make_unique<Scene>(*this, *mRendering.get(), mPhysics.get(), *mNavigator);
+        mWorldScene = std::make_unique<Scene>(*this, *mRendering.get(), mPhysics.get(), *mNavigator, encoder);
     }
 
     void World::fillGlobalVariables()
@@ -1212,6 +1215,7 @@ namespace MWWorld
                     newPtr = currCell->moveTo(ptr, newCell);
                 else // both cells active
                 {
+                    mWorldScene->insertPendingObject(ptr);
                     newPtr = currCell->moveTo(ptr, newCell);
 
                     mRendering->updatePtr(ptr, newPtr);
@@ -3891,6 +3895,11 @@ namespace MWWorld
         return mNavigator.get();
     }
 
+    DetourNavigator::AsyncPathFinder* World::getAsyncPathFinder() const
+    {
+        return mAsyncPathFinder.get();
+    }
+
     void World::updateActorPath(const MWWorld::ConstPtr& actor, const std::deque<osg::Vec3f>& path,
         const DetourNavigator::AgentBounds& agentBounds, const osg::Vec3f& start, const osg::Vec3f& end) const
     {
@@ -3948,6 +3957,7 @@ namespace MWWorld
     {
         DetourNavigator::reportStats(mNavigator->getStats(), frameNumber, stats);
         mPhysics->reportStats(frameNumber, stats);
+        mWorldScene->reportStats(frameNumber, stats);
     }
 
     void World::updateSkyDate()
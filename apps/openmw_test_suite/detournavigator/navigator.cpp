@@ -2,6 +2,7 @@
 #include "settings.hpp"
 
 #include <components/bullethelpers/heightfield.hpp>
+#include <components/detournavigator/asyncpathfinder.hpp>
 #include <components/detournavigator/navigatorimpl.hpp>
 #include <components/detournavigator/navigatorutils.hpp>
 #include <components/detournavigator/navmeshdb.hpp>
@@ -198,6 +199,80 @@ namespace
             << mPath;
     }
 
+    TEST_F(DetourNavigatorNavigatorTest, async_path_finder_should_return_same_path_as_find_path)
+    {
+        constexpr std::array<float, 5 * 5> heightfieldData{ {
+            0, 0, 0, 0, 0, // row 0
+            0, -25, -25, -25, -25, // row 1
+            0, -25, -100, -100, -100, // row 2
+            0, -25, -100, -100, -100, // row 3
+            0, -25, -100, -100, -100, // row 4
+        } };
+        const HeightfieldSurface surface = makeSquareHeightfieldSurface(heightfieldData);
+        const int cellSize = mHeightfieldTileSize * (surface.mSize - 1);
+
+        mNavigator->addAgent(mAgentBounds);
+        mNavigator->addHeightfield(mCellPosition, cellSize, surface, nullptr);
+        mNavigator->update(mPlayerPosition, nullptr);
+        mNavigator->wait(WaitConditionType::requiredTilesPresent, &mListener);
+
+        ASSERT_EQ(
+            findPath(*mNavigator, mAgentBounds, mStepSize, mStart, mEnd, Flag_walk, mAreaCosts, mEndTolerance, mOut),
+            Status::Success);
+
+        AsyncPathFinder pathFinder(*mNavigator);
+        const PathRequest request{ mAgentBounds, mStepSize, mStart, mEnd, Flag_walk, mAreaCosts, mEndTolerance };
+        const std::shared_ptr<const PathResult> result = pathFinder.request(request);
+        pathFinder.waitUntilAllJobsDone();
+
+        ASSERT_TRUE(result->isReady());
+        EXPECT_EQ(result->getStatus(), Status::Success);
+        EXPECT_THAT(result->getPath(), ElementsAreArray(mPath));
+        EXPECT_EQ(pathFinder.getPendingCount(), 0u);
+    }
+
+    TEST_F(DetourNavigatorNavigatorTest, async_path_finder_should_share_result_of_pending_requests)
+    {
+        // Without threads requests stay pending
+        mSettings.mAsyncPathFinderThreads = 0;
+        mNavigator.reset(new NavigatorImpl(
+            mSettings, std::make_unique<NavMeshDb>(":memory:", std::numeric_limits<std::uint64_t>::max())));
+
+        constexpr std::array<float, 5 * 5> heightfieldData{ {
+            0, 0, 0, 0, 0, // row 0
+            0, -25, -25, -25, -25, // row 1
+            0, -25, -100, -100, -100, // row 2
+            0, -25, -100, -100, -100, // row 3
+            0, -25, -100, -100, -100, // row 4
+        } };
+        const HeightfieldSurface surface = makeSquareHeightfieldSurface(heightfieldData);
+        const int cellSize = mHeightfieldTileSize * (surface.mSize - 1);
+
+        mNavigator->addAgent(mAgentBounds);
+        mNavigator->addHeightfield(mCellPosition, cellSize, surface, nullptr);
+        mNavigator->update(mPlayerPosition, nullptr);
+        mNavigator->wait(WaitConditionType::requiredTilesPresent, &mListener);
+
+        AsyncPathFinder pathFinder(*mNavigator);
+        const PathRequest request{ mAgentBounds, mStepSize, mStart, mEnd, Flag_walk, mAreaCosts, mEndTolerance };
+        const std::shared_ptr<const PathResult> result = pathFinder.request(request);
+        const std::shared_ptr<const PathResult> same = pathFinder.request(request);
+
+        EXPECT_EQ(result, same);
+        EXPECT_FALSE(result->isReady());
+        EXPECT_EQ(pathFinder.getPendingCount(), 1u);
+    }
+
+    TEST_F(DetourNavigatorNavigatorTest, async_path_finder_should_return_ready_result_for_unknown_agent)
+    {
+        AsyncPathFinder pathFinder(*mNavigator);
+        const PathRequest request{ mAgentBounds, mStepSize, mStart, mEnd, Flag_walk, mAreaCosts, mEndTolerance };
+        const std::shared_ptr<const PathResult> result = pathFinder.request(request);
+        ASSERT_TRUE(result->isReady());
+        EXPECT_EQ(result->getStatus(), Status::NavMeshNotFound);
+        EXPECT_THAT(result->getPath(), IsEmpty());
+    }
+
     TEST_F(DetourNavigatorNavigatorTest, add_object_should_change_navmesh)
     {
         mSettings.mWaitUntilMinDistanceToPlayer = 0;
@@ -0,0 +1,109 @@
+#include <components/esm/defs.hpp>
+#include <components/esm3/esmreader.hpp>
+#include <components/esm3/esmwriter.hpp>
+#include <components/misc/compression.hpp>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace ESM;
+
+    constexpr std::uint32_t recordName = esm3Recname("TEST");
+
+    void writeRecord(ESMWriter& writer, std::int32_t value)
+    {
+        writer.startRecord(recordName);
+        writer.writeHNT("DATA", value);
+        writer.endRecord(recordName);
+    }
+
+    std::int32_t readRecord(ESMReader& reader)
+    {
+        EXPECT_EQ(reader.getRecName().toInt(), recordName);
+        reader.getRecHeader();
+        std::int32_t value = 0;
+        reader.getHNT(value, "DATA");
+        return value;
+    }
+
+    std::string write(std::size_t blockSize, int uncompressed, int compressed)
+    {
+        std::ostringstream out;
+        ESMWriter writer;
+        writer.setFormat(42);
+        writer.save(out);
+        for (int i = 0; i < uncompressed; ++i)
+            writeRecord(writer, i);
+        writer.setCompressionBlockSize(blockSize);
+        for (int i = 0; i < compressed; ++i)
+            writeRecord(writer, uncompressed + i);
+        writer.close();
+        return out.str();
+    }
+
+    TEST(ESMCompressionTest, records_written_before_compression_should_be_readable_directly)
+    {
+        ESMReader reader;
+        reader.open(std::make_unique<std::istringstream>(write(1024, 2, 100)), "");
+        EXPECT_EQ(readRecord(reader), 0);
+        EXPECT_EQ(readRecord(reader), 1);
+        EXPECT_EQ(reader.getRecName().toInt(), static_cast<std::uint32_t>(REC_ZBLK));
+    }
+
+    TEST(ESMCompressionTest, compressed_records_should_be_grouped_into_blocks)
+    {
+        ESMReader reader;
+        reader.open(std::make_unique<std::istringstream>(write(256, 0, 100)), "");
+        int blocks = 0;
+        std::int32_t expected = 0;
+        while (reader.hasMoreRecs())
+        {
+            ASSERT_EQ(reader.getRecName().toInt(), static_cast<std::uint32_t>(REC_ZBLK));
+            reader.getRecHeader();
+            ESMReader block;
+            block.openCompressedBlock(reader);
+            EXPECT_EQ(block.getFormat(), 42);
+            while (block.hasMoreRecs())
+                EXPECT_EQ(readRecord(block), expected++);
+            ++blocks;
+        }
+        EXPECT_EQ(expected, 100);
+        EXPECT_GT(blocks, 1);
+    }
+
+    TEST(ESMCompressionTest, compressed_file_should_be_smaller)
+    {
+        EXPECT_LT(write(1024 * 1024, 0, 1000).size(), write(0, 0, 1000).size());
+    }
+
+    TEST(ESMCompressionTest, truncated_block_should_not_be_opened)
+    {
+        std::vector<std::byte> block = Misc::compress(std::vector<std::byte>(1024));
+        block.resize(block.size() / 2);
+
+        std::ostringstream out;
+        ESMWriter writer;
+        writer.setFormat(42);
+        writer.save(out);
+        writer.startRecord(REC_ZBLK);
+        writer.startSubRecord("DATA");
+        writer.write(reinterpret_cast<const char*>(block.data()), block.size());
+        writer.endRecord("DATA");
+        writer.endRecord(REC_ZBLK);
+        writer.close();
+
+        ESMReader reader;
+        reader.open(std::make_unique<std::istringstream>(out.str()), "");
+        ASSERT_EQ(reader.getRecName().toInt(), static_cast<std::uint32_t>(REC_ZBLK));
+        reader.getRecHeader();
+        ESMReader blockReader;
+        EXPECT_THROW(blockReader.openCompressedBlock(reader), std::runtime_error);
+    }
+}
@@ -237,6 +237,26 @@ CUSTOM, PLAYER: useInterface.lua
         }
     }
 
+    TEST_F(LuaScriptsContainerTest, BatchedEvent)
+    {
+        LuaUtil::ScriptsContainer scripts1(&mLua, "A");
+        LuaUtil::ScriptsContainer scripts2(&mLua, "B");
+        LuaUtil::ScriptsContainer scripts3(&mLua, "C");
+        EXPECT_TRUE(scripts1.addCustomScript(*mCfg.findId("loadSave2.lua")));
+        EXPECT_TRUE(scripts2.addCustomScript(*mCfg.findId("loadSave2.lua")));
+        EXPECT_TRUE(scripts3.addCustomScript(*mCfg.findId("test1.lua")));
+
+        // Handler of "Set" modifies eventData; every receiver should get its own copy.
+        std::string data = LuaUtil::serialize(mLua.sol().create_table_with("n", 1, "x", 0.5, "y", 3.5));
+        testing::internal::CaptureStdout();
+        LuaUtil::ScriptsContainer::receiveEvent("Set", data, { &scripts1, &scripts3, &scripts2 });
+        LuaUtil::ScriptsContainer::receiveEvent("Print", "", { &scripts1, &scripts2 });
+        EXPECT_EQ(internal::GetCapturedStdout(),
+            "C has received event 'Set', but there are no handlers for this event\n"
+            "A[loadSave2.lua]:\t0.5\t3.5\n"
+            "B[loadSave2.lua]:\t0.5\t3.5\n");
+    }
+
     TEST_F(LuaScriptsContainerTest, RemoveScript)
     {
         LuaUtil::ScriptsContainer scripts(&mLua, "Test");
@@ -1,6 +1,8 @@
 #include "gmock/gmock.h"
 #include <gtest/gtest.h>
 
+#include <cmath>
+
 #include <osg/Matrixf>
 #include <osg/Quat>
 #include <osg/Vec2f>
@@ -36,6 +38,56 @@ namespace
         EXPECT_DOUBLE_EQ(value.as<double>(), 3.14);
     }
 
+    TEST(LuaSerializationTest, IntegralNumber)
+    {
+        sol::state lua;
+        for (double v : { 0.0, 5.0, -128.0, 127.0 })
+        {
+            std::string serialized = LuaUtil::serialize(sol::make_object<double>(lua, v));
+            EXPECT_EQ(serialized.size(), 3); // version, type, 1 byte value
+            sol::object value = LuaUtil::deserialize(lua, serialized);
+            ASSERT_TRUE(value.is<double>());
+            EXPECT_EQ(value.as<double>(), v);
+        }
+        for (double v : { 128.0, -100000.0, 2147483647.0, -2147483648.0 })
+        {
+            std::string serialized = LuaUtil::serialize(sol::make_object<double>(lua, v));
+            EXPECT_EQ(serialized.size(), 6); // version, type, 4 bytes value
+            sol::object value = LuaUtil::deserialize(lua, serialized);
+            ASSERT_TRUE(value.is<double>());
+            EXPECT_EQ(value.as<double>(), v);
+        }
+        for (double v : { -0.0, 2147483648.0, 1e100 })
+        {
+            std::string serialized = LuaUtil::serialize(sol::make_object<double>(lua, v));
+            EXPECT_EQ(serialized.size(), 10); // version, type, 8 bytes value
+            sol::object value = LuaUtil::deserialize(lua, serialized);
+            ASSERT_TRUE(value.is<double>());
+            EXPECT_EQ(value.as<double>(), v);
+            EXPECT_EQ(std::signbit(value.as<double>()), std::signbit(v));
+        }
+    }
+
+    TEST(LuaSerializationTest, ShouldReadFormatVersion0)
+    {
+        sol::state lua;
+        // Version 0 stores every number as a double
+        std::string serialized("\x00\x00", 2);
+        const double number = Misc::toLittleEndian(5.0);
+        serialized.append(reinterpret_cast<const char*>(&number), sizeof(number));
+        sol::object value = LuaUtil::deserialize(lua, serialized);
+        ASSERT_TRUE(value.is<double>());
+        EXPECT_EQ(value.as<double>(), 5.0);
+    }
+
+    TEST(LuaSerializationTest, ShouldRejectUnknownFormatVersion)
+    {
+        sol::state lua;
+        std::string serialized = LuaUtil::serialize(sol::make_object<double>(lua, 5.0));
+        serialized[0] = 2;
+        EXPECT_ERROR(LuaUtil::deserialize(lua, serialized), "Incorrect version of Lua serialization format: 2");
+    }
+
     TEST(LuaSerializationTest, Boolean)
     {
         sol::state lua;
@@ -170,7 +222,7 @@ namespace
         table[2] = osg::Vec2f(2, 1);
 
         std::string serialized = LuaUtil::serialize(table);
-        EXPECT_EQ(serialized.size(), 139);
+        EXPECT_EQ(serialized.size(), 104);
         sol::table res_table = LuaUtil::deserialize(lua, serialized);
         sol::table res_readonly_table = LuaUtil::deserialize(lua, serialized, nullptr, true);
 
@@ -193,6 +245,24 @@ namespace
         EXPECT_ERROR(lua.safe_script("ro_t.nested.x = 5"), "userdata value");
     }
 
+    TEST(LuaSerializationTest, SerializeToExistingBuffer)
+    {
+        sol::state lua;
+        LuaUtil::BinaryDataPool pool;
+        LuaUtil::BinaryData buffer = pool.acquire();
+        buffer.reserve(1024);
+        LuaUtil::serialize(buffer, sol::make_object<std::string_view>(lua, "abc"));
+        EXPECT_EQ(buffer, LuaUtil::serialize(sol::make_object<std::string_view>(lua, "abc")));
+        EXPECT_EQ(LuaUtil::deserialize(lua, buffer).as<std::string>(), "abc");
+
+        pool.release(std::move(buffer));
+        EXPECT_EQ(pool.size(), 1);
+        LuaUtil::BinaryData reused = pool.acquire();
+        EXPECT_TRUE(reused.empty());
+        EXPECT_GE(reused.capacity(), 1024);
+        EXPECT_EQ(pool.size(), 0);
+    }
+
     struct TestStruct1
     {
         double a, b;
@@ -110,4 +110,90 @@ namespace
         EXPECT_TRUE(get<bool>(mLua, "temporary:get('y') == nil"));
     }
 
+    TEST(LuaUtilStorageTest, DeferredCallbacks)
+    {
+        sol::state mLua;
+        LuaUtil::LuaStorage::initLuaBindings(mLua);
+        LuaUtil::LuaStorage storage(mLua);
+        storage.setDeferCallbacks(true);
+
+        std::vector<std::string> callbackCalls;
+        LuaUtil::Callback callback{ sol::make_object(mLua,
+                                        [&](const std::string& section, const sol::optional<std::string>& key) {
+                                            if (key)
+                                                callbackCalls.push_back(section + "_" + *key);
+                                            else
+                                                callbackCalls.push_back(section + "_*");
+                                        }),
+            sol::table(mLua, sol::create) };
+        callback.mHiddenData[LuaUtil::ScriptsContainer::sScriptIdKey] = "fakeId";
+
+        mLua["mutable"] = storage.getMutableSection("test");
+        mLua["mutable"]["subscribe"](mLua["mutable"], callback);
+
+        mLua.safe_script("mutable:set('x', 1)");
+        mLua.safe_script("mutable:set('x', 2)");
+        mLua.safe_script("mutable:set('y', 3)");
+        EXPECT_TRUE(callbackCalls.empty());
+        EXPECT_EQ(get<int>(mLua, "mutable:get('x')"), 2);
+
+        storage.flushCallbacks();
+        EXPECT_THAT(callbackCalls, ::testing::ElementsAre("test_x", "test_y"));
+
+        callbackCalls.clear();
+        mLua.safe_script("mutable:set('x', 4)");
+        mLua.safe_script("mutable:reset({z=5})");
+        mLua.safe_script("mutable:set('y', 6)");
+        storage.flushCallbacks();
+        EXPECT_THAT(callbackCalls, ::testing::ElementsAre("test_*"));
+
+        callbackCalls.clear();
+        storage.flushCallbacks();
+        EXPECT_TRUE(callbackCalls.empty());
+
+        mLua.safe_script("mutable:set('x', 7)");
+        storage.clearTemporaryAndRemoveCallbacks();
+        storage.flushCallbacks();
+        EXPECT_TRUE(callbackCalls.empty());
+    }
+
+    TEST(LuaUtilStorageTest, SavingAfterChanges)
+    {
+        sol::state mLua;
+        LuaUtil::LuaStorage::initLuaBindings(mLua);
+        LuaUtil::LuaStorage storage(mLua);
+
+        mLua["a"] = storage.getMutableSection("a");
+        mLua["b"] = storage.getMutableSection("b");
+        mLua.safe_script("a:set('x', 1)");
+        mLua.safe_script("b:set('y', { z = 'abc' })");
+
+        const auto tmpFile = std::filesystem::temp_directory_path() / "test_storage_changes.bin";
+        storage.save(tmpFile);
+
+        mLua.safe_script("a:set('x', 2)");
+        mLua.safe_script("a:set('w', 3.5)");
+        storage.save(tmpFile);
+
+        LuaUtil::LuaStorage storage2(mLua);
+        storage2.load(tmpFile);
+        mLua["a"] = storage2.getMutableSection("a");
+        mLua["b"] = storage2.getMutableSection("b");
+        EXPECT_EQ(get<int>(mLua, "a:get('x')"), 2);
+        EXPECT_EQ(get<double>(mLua, "a:get('w')"), 3.5);
+        EXPECT_EQ(get<std::string>(mLua, "b:get('y').z"), "abc");
+
+        mLua.safe_script("b:removeOnExit()");
+        storage2.save(tmpFile);
+
+        LuaUtil::LuaStorage storage3(mLua);
+        storage3.load(tmpFile);
+        mLua["a"] = storage3.getMutableSection("a");
+        mLua["b"] = storage3.getMutableSection("b");
+        EXPECT_EQ(get<int>(mLua, "a:get('x')"), 2);
+        EXPECT_TRUE(get<bool>(mLua, "b:get('y') == nil"));
+
+        std::filesystem::remove(tmpFile);
+    }
+
 }
@@ -0,0 +1,97 @@
+#include "gmock/gmock.h"
+#include <gtest/gtest.h>
+
+#include <components/esm/luascripts.hpp>
+
+#include <components/lua/luastate.hpp>
+#include <components/lua/scriptscontainer.hpp>
+#include <components/lua/updatescheduler.hpp>
+
+#include "../testing_util.hpp"
+
+namespace
+{
+    using namespace testing;
+    using namespace TestingOpenMW;
+
+    VFSTestFile updateScript(R"X(
+return {
+    engineHandlers = {
+        onUpdate = function(dt) print('update ' .. tostring(dt)) end,
+    },
+}
+)X");
+
+    struct LuaUpdateSchedulerTest : Test
+    {
+        std::unique_ptr<VFS::Manager> mVFS = createTestVFS({
+            { "update.lua", &updateScript },
+        });
+
+        LuaUtil::ScriptsConfiguration mCfg;
+        LuaUtil::LuaState mLua{ mVFS.get(), &mCfg };
+
+        LuaUtil::ScriptsContainer mNear{ &mLua, "Near" };
+        LuaUtil::ScriptsContainer mFar{ &mLua, "Far" };
+
+        LuaUtil::UpdateScheduler mScheduler;
+
+        LuaUpdateSchedulerTest()
+        {
+            ESM::LuaScriptsCfg cfg;
+            LuaUtil::parseOMWScripts(cfg, "CUSTOM: update.lua");
+            mCfg.init(std::move(cfg));
+            mNear.addCustomScript(*mCfg.findId("update.lua"));
+            mFar.addCustomScript(*mCfg.findId("update.lua"));
+            mScheduler.add(&mNear);
+            mScheduler.add(&mFar);
+        }
+
+        float getPriority(const LuaUtil::ScriptsContainer& container) const { return &container == &mNear ? 0 : 1000; }
+
+        std::string update(float dt)
+        {
+            internal::CaptureStdout();
+            mScheduler.update(dt, [this](const LuaUtil::ScriptsContainer& c) { return getPriority(c); });
+            return internal::GetCapturedStdout();
+        }
+    };
+
+    TEST_F(LuaUpdateSchedulerTest, WithoutBudgetEveryContainerIsUpdatedEveryFrame)
+    {
+        const std::string output = update(0.5f);
+        EXPECT_THAT(output, HasSubstr("Near[update.lua]:\tupdate 0.5\n"));
+        EXPECT_THAT(output, HasSubstr("Far[update.lua]:\tupdate 0.5\n"));
+        EXPECT_EQ(mScheduler.getStats().mUpdated, 2u);
+        EXPECT_EQ(mScheduler.getStats().mDeferred, 0u);
+    }
+
+    TEST_F(LuaUpdateSchedulerTest, DeferredContainerReceivesAccumulatedTime)
+    {
+        LuaUtil::UpdateScheduler::Settings settings;
+        settings.mBudget = std::chrono::nanoseconds(1);
+        settings.mFullRatePriority = 100;
+        settings.mMaxSkippedFrames = 2;
+        mScheduler.setSettings(settings);
+
+        EXPECT_EQ(update(0.5f), "Near[update.lua]:\tupdate 0.5\n");
+        EXPECT_EQ(mScheduler.getStats().mDeferred, 1u);
+        EXPECT_FLOAT_EQ(mScheduler.getPendingTime(&mFar), 0.5f);
+
+        EXPECT_EQ(update(0.25f), "Near[update.lua]:\tupdate 0.25\n");
+        EXPECT_FLOAT_EQ(mScheduler.getPendingTime(&mFar), 0.75f);
+
+        const std::string output = update(0.5f);
+        EXPECT_THAT(output, HasSubstr("Near[update.lua]:\tupdate 0.5\n"));
+        EXPECT_THAT(output, HasSubstr("Far[update.lua]:\tupdate 1.25\n"));
+        EXPECT_EQ(mScheduler.getStats().mDeferred, 0u);
+        EXPECT_FLOAT_EQ(mScheduler.getPendingTime(&mFar), 0);
+    }
+
+    TEST_F(LuaUpdateSchedulerTest, RemovedContainerIsNotUpdated)
+    {
+        mScheduler.remove(&mFar);
+        EXPECT_FALSE(mScheduler.contains(&mFar));
+        EXPECT_EQ(update(0.5f), "Near[update.lua]:\tupdate 0.5\n");
+    }
+}
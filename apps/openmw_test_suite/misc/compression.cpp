@@ -1,10 +1,14 @@
 #include <components/misc/compression.hpp>
+#include <components/misc/endianness.hpp>
 
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <limits>
+#include <stdexcept>
 
 namespace
 {
@@ -15,9 +19,9 @@ namespace
     {
         const std::vector<std::byte> data(1234);
         const std::vector<std::byte> compressed = compress(data);
-        int size = 0;
+        std::uint64_t size = 0;
         std::memcpy(&size, compressed.data(), sizeof(size));
-        EXPECT_EQ(size, data.size());
+        EXPECT_EQ(Misc::fromLittleEndian(size), data.size());
     }
 
     TEST(MiscCompressionTest, decompressIsInverseToCompress)
@@ -28,4 +32,28 @@ namespace
         const std::vector<std::byte> decompressed = decompress(compressed);
         EXPECT_EQ(decompressed, data);
     }
+
+    TEST(MiscCompressionTest, decompressShouldThrowOnDataShorterThanPrefix)
+    {
+        const std::vector<std::byte> data(4);
+        EXPECT_THROW(decompress(data), std::runtime_error);
+    }
+
+    TEST(MiscCompressionTest, decompressShouldThrowOnTruncatedData)
+    {
+        std::vector<std::byte> data(1024);
+        for (std::size_t i = 0; i < data.size(); ++i)
+            data[i] = static_cast<std::byte>(i * 7);
+        std::vector<std::byte> compressed = compress(data);
+        compressed.resize(compressed.size() / 2);
+        EXPECT_THROW(decompress(compressed), std::runtime_error);
+    }
+
+    TEST(MiscCompressionTest, decompressShouldThrowOnInvalidSizePrefix)
+    {
+        std::vector<std::byte> compressed = compress(std::vector<std::byte>(1024));
+        const std::uint64_t size = Misc::toLittleEndian(std::numeric_limits<std::uint64_t>::max());
+        std::memcpy(compressed.data(), &size, sizeof(size));
+        EXPECT_THROW(decompress(compressed), std::runtime_error);
+    }
 }
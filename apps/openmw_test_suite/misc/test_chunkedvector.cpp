@@ -0,0 +1,93 @@
+#include <components/misc/chunkedvector.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <numeric>
+#include <string>
+
+namespace
+{
+    using namespace testing;
+    using namespace Misc;
+
+    TEST(MiscChunkedVectorTest, should_iterate_over_elements_in_order_of_insertion)
+    {
+        ChunkedVector<int, 8> vector;
+        for (int i = 0; i < 100; ++i)
+            vector.push_back(i);
+        std::vector<int> expected(100);
+        std::iota(expected.begin(), expected.end(), 0);
+        EXPECT_THAT(std::vector<int>(vector.begin(), vector.end()), ElementsAreArray(expected));
+        EXPECT_EQ(vector.size(), 100u);
+        EXPECT_EQ(vector.front(), 0);
+        EXPECT_EQ(vector.back(), 99);
+    }
+
+    TEST(MiscChunkedVectorTest, push_back_should_not_move_existing_elements)
+    {
+        ChunkedVector<std::string, 8> vector;
+        vector.push_back("first");
+        const std::string* const first = &vector.front();
+        ChunkedVector<std::string, 8>::iterator firstIt = vector.begin();
+        for (int i = 0; i < 100; ++i)
+            vector.push_back(std::to_string(i));
+        EXPECT_EQ(&vector.front(), first);
+        EXPECT_EQ(&*firstIt, first);
+        EXPECT_EQ(firstIt, vector.begin());
+    }
+
+    TEST(MiscChunkedVectorTest, decrement_of_end_should_point_to_last_element)
+    {
+        ChunkedVector<int, 8> vector;
+        for (int i = 0; i < 12; ++i)
+        {
+            vector.push_back(i);
+            EXPECT_EQ(*--vector.end(), i);
+        }
+    }
+
+    TEST(MiscChunkedVectorTest, erase_should_keep_order_of_other_elements)
+    {
+        ChunkedVector<int, 8> vector;
+        for (int i = 0; i < 20; ++i)
+            vector.push_back(i);
+        for (auto it = vector.begin(); it != vector.end();)
+        {
+            if (*it % 3 == 0)
+                it = vector.erase(it);
+            else
+                ++it;
+        }
+        EXPECT_THAT(std::vector<int>(vector.begin(), vector.end()),
+            ElementsAre(1, 2, 4, 5, 7, 8, 10, 11, 13, 14, 16, 17, 19));
+    }
+
+    TEST(MiscChunkedVectorTest, erase_of_last_element_should_return_end)
+    {
+        ChunkedVector<int, 8> vector;
+        for (int i = 0; i < 4; ++i)
+            vector.push_back(i);
+        const auto it = vector.erase(--vector.end());
+        EXPECT_EQ(it, vector.end());
+        EXPECT_EQ(vector.size(), 3u);
+    }
+
+    TEST(MiscChunkedVectorTest, copy_should_have_same_elements)
+    {
+        ChunkedVector<int, 8> vector;
+        for (int i = 0; i < 20; ++i)
+            vector.push_back(i);
+        const ChunkedVector<int, 8> copy = vector;
+        EXPECT_TRUE(std::equal(vector.begin(), vector.end(), copy.begin(), copy.end()));
+    }
+
+    TEST(MiscChunkedVectorTest, iterator_should_be_convertible_to_const_iterator)
+    {
+        ChunkedVector<int, 8> vector;
+        vector.push_back(42);
+        const ChunkedVector<int, 8>::const_iterator it = vector.begin();
+        EXPECT_EQ(*it, 42);
+        EXPECT_EQ(it, vector.begin());
+    }
+}
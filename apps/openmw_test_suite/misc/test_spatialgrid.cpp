@@ -0,0 +1,111 @@
+#include <components/misc/spatialgrid.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <random>
+
+namespace
+{
+    using namespace testing;
+    using namespace Misc;
+
+    struct MiscSpatialGridTest : Test
+    {
+        SpatialGrid<int> mGrid{ 100.f };
+        std::vector<osg::Vec3f> mPositions;
+
+        MiscSpatialGridTest()
+        {
+            std::minstd_rand random;
+            std::uniform_real_distribution<float> distribution(-1000, 1000);
+            for (int i = 0; i < 500; ++i)
+            {
+                mPositions.emplace_back(distribution(random), distribution(random), distribution(random) / 10);
+                mGrid.insert(mPositions.back(), i);
+            }
+            mGrid.build();
+        }
+    };
+
+    TEST_F(MiscSpatialGridTest, forEachInRadiusShouldFindSameObjectsAsLinearSearch)
+    {
+        const osg::Vec3f center(120, -340, 0);
+        const float radius = 250;
+        std::vector<int> expected;
+        for (std::size_t i = 0; i < mPositions.size(); ++i)
+            if ((mPositions[i] - center).length() <= radius)
+                expected.push_back(static_cast<int>(i));
+        std::vector<int> found;
+        mGrid.forEachInRadius(center, radius, [&](int v, const osg::Vec3f&) { found.push_back(v); });
+        EXPECT_THAT(found, UnorderedElementsAreArray(expected));
+    }
+
+    TEST_F(MiscSpatialGridTest, forEachInBoxShouldFindSameObjectsAsLinearSearch)
+    {
+        const osg::Vec3f min(-500, 0, -20);
+        const osg::Vec3f max(-100, 700, 30);
+        std::vector<int> expected;
+        for (std::size_t i = 0; i < mPositions.size(); ++i)
+        {
+            const osg::Vec3f& p = mPositions[i];
+            if (p.x() >= min.x() && p.x() <= max.x() && p.y() >= min.y() && p.y() <= max.y() && p.z() >= min.z()
+                && p.z() <= max.z())
+                expected.push_back(static_cast<int>(i));
+        }
+        std::vector<int> found;
+        mGrid.forEachInBox(min, max, [&](int v, const osg::Vec3f&) { found.push_back(v); });
+        EXPECT_THAT(found, UnorderedElementsAreArray(expected));
+    }
+
+    TEST_F(MiscSpatialGridTest, findNearestShouldReturnClosestObjectsSortedByDistance)
+    {
+        const osg::Vec3f center(3000, 3000, 0);
+        std::vector<float> distances;
+        for (const osg::Vec3f& p : mPositions)
+            distances.push_back((p - center).length());
+        std::sort(distances.begin(), distances.end());
+
+        std::vector<std::pair<float, int>> found;
+        mGrid.findNearest(center, 5, std::numeric_limits<float>::max(), found);
+        ASSERT_EQ(found.size(), 5);
+        for (std::size_t i = 0; i < found.size(); ++i)
+            EXPECT_FLOAT_EQ(found[i].first, distances[i]);
+    }
+
+    TEST_F(MiscSpatialGridTest, findNearestShouldIgnoreObjectsFartherThanMaxDistance)
+    {
+        std::vector<std::pair<float, int>> found;
+        mGrid.findNearest(osg::Vec3f(1e5f, 1e5f, 0), 5, 1000, found);
+        EXPECT_THAT(found, IsEmpty());
+    }
+
+    TEST_F(MiscSpatialGridTest, forEachInRadiusShouldFindSamePairsAsLinearSearchForEveryObject)
+    {
+        const float radius = 150;
+        std::size_t expected = 0;
+        std::size_t found = 0;
+        for (std::size_t i = 0; i < mPositions.size(); ++i)
+        {
+            for (const osg::Vec3f& p : mPositions)
+                if ((p - mPositions[i]).length() <= radius)
+                    ++expected;
+            mGrid.forEachInRadius(mPositions[i], radius, [&](int v, const osg::Vec3f& position) {
+                EXPECT_EQ(position, mPositions[v]);
+                ++found;
+            });
+        }
+        EXPECT_EQ(found, expected);
+    }
+
+    TEST(MiscSpatialGridEmptyTest, queriesShouldFindNothing)
+    {
+        SpatialGrid<int> grid(100.f);
+        grid.build();
+        std::vector<std::pair<float, int>> found;
+        grid.findNearest(osg::Vec3f(), 5, 1000, found);
+        EXPECT_THAT(found, IsEmpty());
+        grid.forEachInRadius(osg::Vec3f(), 1000, [&](int v, const osg::Vec3f&) { found.emplace_back(0, v); });
+        EXPECT_THAT(found, IsEmpty());
+    }
+}
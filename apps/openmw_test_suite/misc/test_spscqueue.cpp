@@ -0,0 +1,75 @@
+#include <components/misc/spscqueue.hpp>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <thread>
+
+namespace
+{
+    using namespace testing;
+    using namespace Misc;
+
+    TEST(MiscSpscQueueTest, pop_from_empty_queue_should_fail)
+    {
+        SpscQueue<int> queue(4);
+        EXPECT_TRUE(queue.empty());
+        EXPECT_EQ(queue.pop(), std::nullopt);
+    }
+
+    TEST(MiscSpscQueueTest, pop_should_return_values_in_order_of_push)
+    {
+        SpscQueue<int> queue(4);
+        EXPECT_TRUE(queue.push(1));
+        EXPECT_TRUE(queue.push(2));
+        EXPECT_EQ(queue.size(), 2u);
+        EXPECT_EQ(queue.pop(), 1);
+        EXPECT_EQ(queue.pop(), 2);
+        EXPECT_EQ(queue.pop(), std::nullopt);
+    }
+
+    TEST(MiscSpscQueueTest, push_to_full_queue_should_fail)
+    {
+        SpscQueue<int> queue(2);
+        EXPECT_TRUE(queue.push(1));
+        EXPECT_TRUE(queue.push(2));
+        EXPECT_TRUE(queue.full());
+        EXPECT_FALSE(queue.push(3));
+        EXPECT_EQ(queue.pop(), 1);
+        EXPECT_TRUE(queue.push(3));
+        EXPECT_EQ(queue.pop(), 2);
+        EXPECT_EQ(queue.pop(), 3);
+    }
+
+    TEST(MiscSpscQueueTest, should_support_move_only_values)
+    {
+        SpscQueue<std::unique_ptr<int>> queue(1);
+        EXPECT_TRUE(queue.push(std::make_unique<int>(42)));
+        const std::optional<std::unique_ptr<int>> value = queue.pop();
+        ASSERT_TRUE(value.has_value());
+        EXPECT_EQ(**value, 42);
+    }
+
+    TEST(MiscSpscQueueTest, consumer_should_receive_all_values_from_producer_thread)
+    {
+        constexpr int count = 100000;
+        SpscQueue<int> queue(16);
+        std::thread producer([&] {
+            for (int i = 0; i < count;)
+                if (queue.push(int(i)))
+                    ++i;
+                else
+                    std::this_thread::yield();
+        });
+        int expected = 0;
+        while (expected < count)
+        {
+            if (const std::optional<int> value = queue.pop())
+                ASSERT_EQ(*value, expected++);
+            else
+                std::this_thread::yield();
+        }
+        producer.join();
+        EXPECT_TRUE(queue.empty());
+    }
+}
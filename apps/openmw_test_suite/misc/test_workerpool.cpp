@@ -0,0 +1,55 @@
+#include <components/misc/workerpool.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+
+namespace
+{
+    using namespace testing;
+    using namespace Misc;
+
+    struct MiscWorkerPoolTest : TestWithParam<unsigned>
+    {
+    };
+
+    TEST_P(MiscWorkerPoolTest, forEachShouldCallFunctionForEveryIndexOnce)
+    {
+        WorkerPool pool(GetParam());
+        std::vector<int> calls(1000, 0);
+        pool.forEach(calls.size(), [&](std::size_t i) { ++calls[i]; });
+        EXPECT_THAT(calls, Each(1));
+    }
+
+    TEST_P(MiscWorkerPoolTest, forEachShouldBeReusable)
+    {
+        WorkerPool pool(GetParam());
+        for (std::size_t size = 0; size < 100; ++size)
+        {
+            std::vector<std::size_t> values(size, 0);
+            pool.forEach(values.size(), [&](std::size_t i) { values[i] = i; });
+            std::vector<std::size_t> expected(size);
+            std::iota(expected.begin(), expected.end(), 0);
+            EXPECT_EQ(values, expected);
+        }
+    }
+
+    TEST_P(MiscWorkerPoolTest, forEachShouldRethrowException)
+    {
+        WorkerPool pool(GetParam());
+        EXPECT_THROW(pool.forEach(100,
+                         [](std::size_t i) {
+                             if (i == 42)
+                                 throw std::runtime_error("error");
+                         }),
+            std::runtime_error);
+        std::atomic<std::size_t> calls{ 0 };
+        pool.forEach(100, [&](std::size_t) { ++calls; });
+        EXPECT_EQ(calls, 100u);
+    }
+
+    INSTANTIATE_TEST_SUITE_P(ThreadsCount, MiscWorkerPoolTest, Values(0u, 1u, 4u));
+}
@@ -0,0 +1,109 @@
+#include "apps/openmw/mwsound/loudness.hpp"
+#include "apps/openmw/mwsound/loudnesscache.hpp"
+
+#include "../testing_util.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <fstream>
+#include <limits>
+
+namespace
+{
+    using namespace testing;
+    using namespace MWSound;
+
+    const std::string sFileName = "sound/vo/a.mp3";
+
+    struct MWSoundLoudnessCacheTest : Test
+    {
+        const std::filesystem::path mPath = TestingOpenMW::temporaryFilePath("openmw_test_loudness_cache.bin");
+        TestingOpenMW::VFSTestFile mFile{ "voice" };
+        TestingOpenMW::VFSTestFile mChangedFile{ "changed voice" };
+
+        MWSoundLoudnessCacheTest() { std::filesystem::remove(mPath); }
+
+        ~MWSoundLoudnessCacheTest() override { std::filesystem::remove(mPath); }
+
+        void save()
+        {
+            const auto vfs = TestingOpenMW::createTestVFS({ { sFileName, &mFile } });
+            LoudnessCache cache(*vfs, mPath);
+            cache.add(sFileName, std::make_shared<const Sound_Loudness>(20.0f, std::vector<float>{ 0.25f, 0.5f }));
+        }
+
+        std::shared_ptr<const Sound_Loudness> load(VFS::File& file)
+        {
+            const auto vfs = TestingOpenMW::createTestVFS({ { sFileName, &file } });
+            LoudnessCache cache(*vfs, mPath);
+            cache.wait();
+            return cache.get(sFileName);
+        }
+
+        template <class T>
+        void overwrite(std::streamoff offset, T value)
+        {
+            std::fstream stream(mPath, std::ios::binary | std::ios::in | std::ios::out);
+            stream.seekp(offset);
+            stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+    };
+
+    TEST_F(MWSoundLoudnessCacheTest, added_loudness_should_be_available_after_hashing)
+    {
+        const auto vfs = TestingOpenMW::createTestVFS({ { sFileName, &mFile } });
+        LoudnessCache cache(*vfs, mPath);
+        const auto loudness = std::make_shared<const Sound_Loudness>(20.0f, std::vector<float>{ 0.25f });
+        cache.add(sFileName, loudness);
+        cache.wait();
+        EXPECT_EQ(cache.get(sFileName), loudness);
+    }
+
+    TEST_F(MWSoundLoudnessCacheTest, loudness_should_be_saved_and_loaded)
+    {
+        save();
+        const std::shared_ptr<const Sound_Loudness> loudness = load(mFile);
+        ASSERT_NE(loudness, nullptr);
+        EXPECT_EQ(loudness->getSamplesPerSecond(), 20.0f);
+        EXPECT_THAT(loudness->getSamples(), ElementsAre(0.25f, 0.5f));
+    }
+
+    TEST_F(MWSoundLoudnessCacheTest, loaded_loudness_of_changed_file_should_not_be_used)
+    {
+        save();
+        EXPECT_EQ(load(mChangedFile), nullptr);
+    }
+
+    TEST_F(MWSoundLoudnessCacheTest, loaded_loudness_of_removed_file_should_not_be_used)
+    {
+        save();
+        const auto vfs = TestingOpenMW::createTestVFS({});
+        LoudnessCache cache(*vfs, mPath);
+        cache.wait();
+        EXPECT_EQ(cache.get(sFileName), nullptr);
+    }
+
+    TEST_F(MWSoundLoudnessCacheTest, truncated_file_should_not_be_loaded)
+    {
+        save();
+        std::filesystem::resize_file(mPath, std::filesystem::file_size(mPath) - sizeof(float));
+        EXPECT_EQ(load(mFile), nullptr);
+    }
+
+    TEST_F(MWSoundLoudnessCacheTest, file_with_too_many_samples_should_not_be_loaded)
+    {
+        save();
+        // Magic, version, entries count, file name size, file name, hash and samples per second come first
+        overwrite(4 + 4 + 4 + 4 + sFileName.size() + 16 + 4, std::numeric_limits<std::uint32_t>::max());
+        EXPECT_EQ(load(mFile), nullptr);
+    }
+
+    TEST_F(MWSoundLoudnessCacheTest, file_of_other_version_should_not_be_loaded)
+    {
+        save();
+        overwrite(4, std::uint32_t{ 2 });
+        EXPECT_EQ(load(mFile), nullptr);
+    }
+}
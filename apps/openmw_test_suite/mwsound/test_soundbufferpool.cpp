@@ -0,0 +1,189 @@
+#include "apps/openmw/mwsound/sound_buffer.hpp"
+
+#include "../testing_util.hpp"
+
+#include <components/settings/settings.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <map>
+
+namespace MWSound
+{
+    struct DecodedSound
+    {
+        bool mDone = false;
+    };
+}
+
+namespace
+{
+    using namespace testing;
+    using namespace MWSound;
+
+    constexpr std::size_t sBufferSize = 1024 * 1024;
+
+    struct TestBufferLoader final : Sound_BufferLoader
+    {
+        std::map<std::string, DecodedSoundPtr> mDecoding;
+        std::uintptr_t mLastHandle = 0;
+        std::size_t mUnloaded = 0;
+        std::size_t mUnloadedNull = 0;
+
+        DecodedSoundPtr decodeSound(const std::string& fname) override
+        {
+            auto sound = std::make_shared<DecodedSound>();
+            mDecoding[fname] = sound;
+            return sound;
+        }
+
+        bool isSoundDecoded(const DecodedSound& sound) override { return sound.mDone; }
+
+        std::pair<Sound_Handle, size_t> loadSound(const DecodedSound& /*sound*/) override
+        {
+            return { reinterpret_cast<Sound_Handle>(++mLastHandle), sBufferSize };
+        }
+
+        size_t unloadSound(Sound_Handle data) override
+        {
+            if (data == nullptr)
+                ++mUnloadedNull;
+            ++mUnloaded;
+            return sBufferSize;
+        }
+
+        void finishDecoding(const Sound_Buffer& sfx) { mDecoding.at(sfx.getResourceName())->mDone = true; }
+    };
+
+    struct MWSoundSoundBufferPoolTest : Test
+    {
+        std::unique_ptr<VFS::Manager> mVfs = TestingOpenMW::createTestVFS({});
+        TestBufferLoader mLoader;
+
+        MWSoundSoundBufferPoolTest()
+        {
+            Settings::Manager::setInt("buffer cache max", "Sound", 2);
+            Settings::Manager::setInt("buffer cache min", "Sound", 1);
+        }
+
+        Sound_Buffer* loadDecoded(SoundBufferPool& pool, const std::string& soundId)
+        {
+            pool.insert(soundId, soundId + ".wav", 1, 1, 2);
+            Sound_Buffer* const sfx = pool.load(soundId);
+            mLoader.finishDecoding(*sfx);
+            pool.update();
+            return sfx;
+        }
+    };
+
+    TEST_F(MWSoundSoundBufferPoolTest, load_should_start_decoding_and_update_should_finish_loading)
+    {
+        SoundBufferPool pool(*mVfs, mLoader);
+        pool.insert("a", "a.wav", 1, 1, 2);
+        Sound_Buffer* const sfx = pool.load("a");
+        ASSERT_NE(sfx, nullptr);
+        EXPECT_TRUE(sfx->isLoading());
+        EXPECT_EQ(sfx->getHandle(), nullptr);
+        EXPECT_EQ(pool.lookup("a"), sfx);
+        EXPECT_EQ(mLoader.mDecoding.size(), 1u);
+
+        pool.update();
+        EXPECT_TRUE(sfx->isLoading());
+        EXPECT_EQ(sfx->getHandle(), nullptr);
+
+        mLoader.finishDecoding(*sfx);
+        pool.update();
+        EXPECT_FALSE(sfx->isLoading());
+        EXPECT_NE(sfx->getHandle(), nullptr);
+        EXPECT_EQ(pool.lookup("a"), sfx);
+    }
+
+    TEST_F(MWSoundSoundBufferPoolTest, load_should_not_decode_loading_buffer_again)
+    {
+        SoundBufferPool pool(*mVfs, mLoader);
+        pool.insert("a", "a.wav", 1, 1, 2);
+        Sound_Buffer* const sfx = pool.load("a");
+        const DecodedSoundPtr decoded = mLoader.mDecoding.at(sfx->getResourceName());
+        EXPECT_EQ(pool.load("a"), sfx);
+        EXPECT_EQ(mLoader.mDecoding.at(sfx->getResourceName()), decoded);
+    }
+
+    TEST_F(MWSoundSoundBufferPoolTest, lookup_should_not_return_not_loaded_buffer)
+    {
+        SoundBufferPool pool(*mVfs, mLoader);
+        pool.insert("a", "a.wav", 1, 1, 2);
+        EXPECT_EQ(pool.lookup("a"), nullptr);
+    }
+
+    TEST_F(MWSoundSoundBufferPoolTest, buffer_released_while_loading_and_used_again_should_not_be_unloaded)
+    {
+        SoundBufferPool pool(*mVfs, mLoader);
+        pool.insert("a", "a.wav", 1, 1, 2);
+        Sound_Buffer* const sfx = pool.load("a");
+        pool.use(*sfx);
+        pool.release(*sfx);
+        mLoader.finishDecoding(*sfx);
+        pool.update();
+        ASSERT_NE(sfx->getHandle(), nullptr);
+
+        pool.use(*sfx);
+        loadDecoded(pool, "b");
+        loadDecoded(pool, "c");
+        EXPECT_EQ(mLoader.mUnloaded, 1u);
+        EXPECT_NE(sfx->getHandle(), nullptr);
+    }
+
+    TEST_F(MWSoundSoundBufferPoolTest, buffer_released_while_loading_should_be_unloaded_once_loaded)
+    {
+        SoundBufferPool pool(*mVfs, mLoader);
+        pool.insert("a", "a.wav", 1, 1, 2);
+        Sound_Buffer* const sfx = pool.load("a");
+        pool.use(*sfx);
+        pool.release(*sfx);
+        mLoader.finishDecoding(*sfx);
+        pool.update();
+        ASSERT_NE(sfx->getHandle(), nullptr);
+
+        loadDecoded(pool, "b");
+        loadDecoded(pool, "c");
+        EXPECT_EQ(sfx->getHandle(), nullptr);
+        EXPECT_EQ(pool.lookup("a"), nullptr);
+    }
+
+    TEST_F(MWSoundSoundBufferPoolTest, unload_unused_should_skip_loading_buffers)
+    {
+        SoundBufferPool pool(*mVfs, mLoader);
+        pool.insert("a", "a.wav", 1, 1, 2);
+        Sound_Buffer* const sfx = pool.load("a");
+        pool.use(*sfx);
+        pool.release(*sfx);
+
+        loadDecoded(pool, "b");
+        loadDecoded(pool, "c");
+        loadDecoded(pool, "d");
+        EXPECT_EQ(mLoader.mUnloaded, 2u);
+        EXPECT_EQ(mLoader.mUnloadedNull, 0u);
+        EXPECT_TRUE(sfx->isLoading());
+        EXPECT_EQ(pool.lookup("a"), sfx);
+
+        mLoader.finishDecoding(*sfx);
+        pool.update();
+        EXPECT_FALSE(sfx->isLoading());
+        EXPECT_NE(sfx->getHandle(), nullptr);
+    }
+
+    TEST_F(MWSoundSoundBufferPoolTest, clear_should_unload_loaded_and_forget_loading_buffers)
+    {
+        SoundBufferPool pool(*mVfs, mLoader);
+        Sound_Buffer* const loaded = loadDecoded(pool, "a");
+        pool.insert("b", "b.wav", 1, 1, 2);
+        Sound_Buffer* const loading = pool.load("b");
+        pool.clear();
+        EXPECT_EQ(mLoader.mUnloaded, 1u);
+        EXPECT_EQ(loaded->getHandle(), nullptr);
+        EXPECT_FALSE(loading->isLoading());
+        EXPECT_EQ(pool.lookup("a"), nullptr);
+        EXPECT_EQ(pool.lookup("b"), nullptr);
+    }
+}
@@ -0,0 +1,48 @@
+#include "apps/openmw/mwstate/blockdecompressor.hpp"
+
+#include <components/misc/compression.hpp>
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+namespace
+{
+    using namespace testing;
+    using namespace MWState;
+
+    std::vector<std::byte> makeBlock(std::size_t size, std::byte value)
+    {
+        return std::vector<std::byte>(size, value);
+    }
+
+    TEST(MWStateBlockDecompressorTest, should_return_blocks_in_order)
+    {
+        std::vector<std::vector<std::byte>> blocks;
+        for (int i = 0; i < 100; ++i)
+            blocks.push_back(Misc::compress(makeBlock(1000 + i, static_cast<std::byte>(i))));
+        BlockDecompressor decompressor(std::move(blocks));
+        ASSERT_EQ(decompressor.getSize(), 100u);
+        for (int i = 0; i < 100; ++i)
+            EXPECT_EQ(decompressor.get(i), makeBlock(1000 + i, static_cast<std::byte>(i)));
+    }
+
+    TEST(MWStateBlockDecompressorTest, should_rethrow_decompression_error)
+    {
+        std::vector<std::byte> block = Misc::compress(makeBlock(1000, std::byte{ 0 }));
+        block[0] = std::byte{ 0xff }; // Corrupt the stored size
+        std::vector<std::vector<std::byte>> blocks;
+        blocks.push_back(std::move(block));
+        BlockDecompressor decompressor(std::move(blocks));
+        EXPECT_THROW(decompressor.get(0), std::exception);
+    }
+
+    TEST(MWStateBlockDecompressorTest, should_stop_when_blocks_are_not_taken)
+    {
+        std::vector<std::vector<std::byte>> blocks;
+        for (int i = 0; i < 100; ++i)
+            blocks.push_back(Misc::compress(makeBlock(1000, std::byte{ 0 })));
+        BlockDecompressor decompressor(std::move(blocks));
+        EXPECT_EQ(decompressor.get(0), makeBlock(1000, std::byte{ 0 }));
+    }
+}
@@ -0,0 +1,80 @@
+#include <components/resource/bulletshape.hpp>
+
+#include <BulletCollision/BroadphaseCollision/btDbvt.h>
+#include <BulletCollision/CollisionShapes/btBoxShape.h>
+#include <BulletCollision/CollisionShapes/btCompoundShape.h>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+namespace
+{
+    using namespace testing;
+    using namespace Resource;
+
+    osg::ref_ptr<BulletShape> makeCompoundBulletShape(int childrenCount)
+    {
+        std::unique_ptr<btCompoundShape> compound = std::make_unique<btCompoundShape>();
+        for (int i = 0; i < childrenCount; ++i)
+        {
+            btTransform transform = btTransform::getIdentity();
+            transform.setOrigin(btVector3(static_cast<btScalar>(i * 10), 0, 0));
+            compound->addChildShape(transform, new btBoxShape(btVector3(1, 2, 3)));
+        }
+        osg::ref_ptr<BulletShape> shape(new BulletShape);
+        shape->mCollisionShape.reset(compound.release());
+        return shape;
+    }
+
+    btCompoundShape& getCompound(const BulletShape& shape)
+    {
+        return static_cast<btCompoundShape&>(*shape.mCollisionShape);
+    }
+
+    TEST(ResourceBulletShapeInstanceTest, compound_shape_instance_should_have_tree_with_node_for_each_child)
+    {
+        const osg::ref_ptr<BulletShape> source = makeCompoundBulletShape(5);
+        const osg::ref_ptr<BulletShapeInstance> instance = makeInstance(source);
+        const btCompoundShape& compound = getCompound(*instance);
+        ASSERT_NE(compound.getDynamicAabbTree(), nullptr);
+        EXPECT_NE(compound.getDynamicAabbTree(), getCompound(*source).getDynamicAabbTree());
+        EXPECT_EQ(compound.getDynamicAabbTree()->m_leaves, 5);
+        for (int i = 0; i < compound.getNumChildShapes(); ++i)
+        {
+            const btDbvtNode* node = compound.getChildList()[i].m_node;
+            ASSERT_NE(node, nullptr);
+            EXPECT_TRUE(node->isleaf());
+            EXPECT_EQ(node->dataAsInt, i);
+        }
+    }
+
+    TEST(ResourceBulletShapeInstanceTest, compound_shape_instance_should_update_tree_on_scaling)
+    {
+        const osg::ref_ptr<BulletShape> source = makeCompoundBulletShape(3);
+        const osg::ref_ptr<BulletShapeInstance> instance = makeInstance(source);
+        instance->setLocalScaling(btVector3(2, 2, 2));
+        const btCompoundShape& compound = getCompound(*instance);
+        const btDbvtNode* node = compound.getChildList()[2].m_node;
+        ASSERT_NE(node, nullptr);
+        EXPECT_NEAR(node->volume.Center().x(), 40, 1e-3);
+        btVector3 aabbMin;
+        btVector3 aabbMax;
+        compound.getAabb(btTransform::getIdentity(), aabbMin, aabbMax);
+        EXPECT_NEAR(aabbMax.x(), 42, 0.1);
+    }
+
+    TEST(ResourceBulletShapeInstanceTest, compound_shape_instance_should_support_child_removal)
+    {
+        const osg::ref_ptr<BulletShape> source = makeCompoundBulletShape(3);
+        const osg::ref_ptr<BulletShapeInstance> instance = makeInstance(source);
+        btCompoundShape& compound = getCompound(*instance);
+        btCollisionShape* child = compound.getChildShape(0);
+        compound.removeChildShapeByIndex(0);
+        delete child;
+        EXPECT_EQ(compound.getNumChildShapes(), 2);
+        EXPECT_EQ(compound.getDynamicAabbTree()->m_leaves, 2);
+        for (int i = 0; i < compound.getNumChildShapes(); ++i)
+            EXPECT_EQ(compound.getChildList()[i].m_node->dataAsInt, i);
+    }
+}
@@ -0,0 +1,155 @@
+#include "asyncpathfinder.hpp"
+#include "findsmoothpath.hpp"
+#include "navigator.hpp"
+#include "navmeshcacheitem.hpp"
+#include "settingsutils.hpp"
+
+#include <components/debug/debuglog.hpp>
+
+#include <iterator>
+
+namespace DetourNavigator
+{
+    AsyncPathFinder::AsyncPathFinder(const Navigator& navigator)
+        : mNavigator(navigator)
+        , mSettings(navigator.getSettings())
+    {
+        for (std::size_t i = 0; i < mSettings.mAsyncPathFinderThreads; ++i)
+            mThreads.emplace_back([&] { process(); });
+    }
+
+    AsyncPathFinder::~AsyncPathFinder()
+    {
+        stop();
+    }
+
+    std::shared_ptr<const PathResult> AsyncPathFinder::request(const PathRequest& request)
+    {
+        // Navmesh lookup is not thread safe, so the navmesh is captured here and only its content is accessed by
+        // the workers under the lock.
+        SharedNavMeshCacheItem navMesh = mNavigator.getNavMesh(request.mAgentBounds);
+        if (navMesh == nullptr)
+        {
+            auto result = std::make_shared<PathResult>();
+            result->mStatus = Status::NavMeshNotFound;
+            result->mReady.store(true, std::memory_order_release);
+            return result;
+        }
+
+        const RequestKey key = makeKey(request);
+
+        const std::lock_guard lock(mMutex);
+
+        const auto it = mPending.find(key);
+        if (it != mPending.end())
+        {
+            if (std::shared_ptr<PathResult> result = it->second.lock())
+                return result;
+            mPending.erase(it);
+        }
+
+        auto result = std::make_shared<PathResult>();
+        mJobs.push_back(Job{ request, std::move(navMesh), result });
+        mPending.emplace(key, result);
+        mHasJob.notify_one();
+
+        return result;
+    }
+
+    void AsyncPathFinder::waitUntilAllJobsDone()
+    {
+        std::unique_lock lock(mMutex);
+        mDone.wait(lock, [&] { return mShouldStop || (mJobs.empty() && mProcessing == 0); });
+    }
+
+    std::size_t AsyncPathFinder::getPendingCount() const
+    {
+        const std::lock_guard lock(mMutex);
+        return mJobs.size() + mProcessing;
+    }
+
+    void AsyncPathFinder::stop()
+    {
+        {
+            const std::lock_guard lock(mMutex);
+            mShouldStop = true;
+            mJobs.clear();
+            mPending.clear();
+        }
+        mHasJob.notify_all();
+        mDone.notify_all();
+        for (auto& thread : mThreads)
+            if (thread.joinable())
+                thread.join();
+    }
+
+    AsyncPathFinder::RequestKey AsyncPathFinder::makeKey(const PathRequest& request)
+    {
+        return RequestKey(request.mAgentBounds, request.mStepSize, request.mStart, request.mEnd,
+            request.mIncludeFlags, request.mAreaCosts.mWater, request.mAreaCosts.mDoor, request.mAreaCosts.mPathgrid,
+            request.mAreaCosts.mGround, request.mEndTolerance);
+    }
+
+    void AsyncPathFinder::process() noexcept
+    {
+        Log(Debug::Debug) << "Start process path requests by thread=" << std::this_thread::get_id();
+        while (true)
+        {
+            std::unique_lock lock(mMutex);
+            mHasJob.wait(lock, [&] { return mShouldStop || !mJobs.empty(); });
+            if (mShouldStop)
+                break;
+
+            const Job job = std::move(mJobs.front());
+            mJobs.pop_front();
+
+            const std::shared_ptr<PathResult> result = job.mResult.lock();
+            if (result == nullptr)
+            {
+                const auto it = mPending.find(makeKey(job.mRequest));
+                if (it != mPending.end() && it->second.expired())
+                    mPending.erase(it);
+                if (mJobs.empty() && mProcessing == 0)
+                    mDone.notify_all();
+                continue;
+            }
+
+            ++mProcessing;
+            lock.unlock();
+
+            try
+            {
+                processJob(job, *result);
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Error) << "AsyncPathFinder::process exception: " << e.what();
+                result->mStatus = Status::FindPathOverPolygonsFailed;
+                result->mPath.clear();
+            }
+
+            result->mReady.store(true, std::memory_order_release);
+
+            lock.lock();
+            // A new request with the same key may be made after this one is taken by the worker.
+            const auto it = mPending.find(makeKey(job.mRequest));
+            if (it != mPending.end() && it->second.lock() == result)
+                mPending.erase(it);
+            --mProcessing;
+            if (mJobs.empty() && mProcessing == 0)
+                mDone.notify_all();
+        }
+        Log(Debug::Debug) << "Stop path requests processing by thread=" << std::this_thread::get_id();
+    }
+
+    void AsyncPathFinder::processJob(const Job& job, PathResult& result) const
+    {
+        const PathRequest& request = job.mRequest;
+        const RecastSettings& recast = mSettings.mRecast;
+        result.mStatus = findSmoothPath(job.mNavMesh->lockConst()->getImpl(),
+            toNavMeshCoordinates(recast, request.mAgentBounds.mHalfExtents),
+            toNavMeshCoordinates(recast, request.mStepSize), toNavMeshCoordinates(recast, request.mStart),
+            toNavMeshCoordinates(recast, request.mEnd), request.mIncludeFlags, request.mAreaCosts, mSettings,
+            request.mEndTolerance, std::back_inserter(result.mPath));
+    }
+}
@@ -0,0 +1,103 @@
+#ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_ASYNCPATHFINDER_H
+#define OPENMW_COMPONENTS_DETOURNAVIGATOR_ASYNCPATHFINDER_H
+
+#include "agentbounds.hpp"
+#include "areatype.hpp"
+#include "flags.hpp"
+#include "settings.hpp"
+#include "sharednavmeshcacheitem.hpp"
+#include "status.hpp"
+
+#include <osg/Vec3f>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace DetourNavigator
+{
+    struct Navigator;
+
+    struct PathRequest
+    {
+        AgentBounds mAgentBounds;
+        float mStepSize = 0;
+        osg::Vec3f mStart;
+        osg::Vec3f mEnd;
+        Flags mIncludeFlags = Flag_none;
+        AreaCosts mAreaCosts;
+        float mEndTolerance = 0;
+    };
+
+    class PathResult
+    {
+    public:
+        bool isReady() const { return mReady.load(std::memory_order_acquire); }
+
+        // Status and path are valid only when isReady returns true.
+        Status getStatus() const { return mStatus; }
+
+        const std::vector<osg::Vec3f>& getPath() const { return mPath; }
+
+    private:
+        std::atomic_bool mReady{ false };
+        Status mStatus = Status::NavMeshNotFound;
+        std::vector<osg::Vec3f> mPath;
+
+        friend class AsyncPathFinder;
+    };
+
+    // Finds paths over navmesh in background threads. Requests are made from the main thread, the result is polled
+    // by the caller. Pending requests with the same parameters share a result. A request is dropped without
+    // processing if nobody holds its result anymore.
+    class AsyncPathFinder
+    {
+    public:
+        explicit AsyncPathFinder(const Navigator& navigator);
+        ~AsyncPathFinder();
+
+        std::shared_ptr<const PathResult> request(const PathRequest& request);
+
+        void waitUntilAllJobsDone();
+
+        std::size_t getPendingCount() const;
+
+        void stop();
+
+    private:
+        using RequestKey = std::tuple<AgentBounds, float, osg::Vec3f, osg::Vec3f, Flags, float, float, float, float,
+            float>;
+
+        struct Job
+        {
+            PathRequest mRequest;
+            SharedNavMeshCacheItem mNavMesh;
+            std::weak_ptr<PathResult> mResult;
+        };
+
+        const Navigator& mNavigator;
+        const Settings mSettings;
+        mutable std::mutex mMutex;
+        std::condition_variable mHasJob;
+        std::condition_variable mDone;
+        bool mShouldStop = false;
+        std::size_t mProcessing = 0;
+        std::deque<Job> mJobs;
+        std::map<RequestKey, std::weak_ptr<PathResult>> mPending;
+        std::vector<std::thread> mThreads;
+
+        static RequestKey makeKey(const PathRequest& request);
+
+        void process() noexcept;
+
+        void processJob(const Job& job, PathResult& result) const;
+    };
+}
+
+#endif
@@ -60,6 +60,7 @@ namespace DetourNavigator
             = ::Settings::Manager::getInt("wait until min distance to player", "Navigator");
         result.mAsyncNavMeshUpdaterThreads
             = ::Settings::Manager::getSize("async nav mesh updater threads", "Navigator");
+        result.mAsyncPathFinderThreads = ::Settings::Manager::getSize("async path finder threads", "Navigator");
         result.mMaxNavMeshTilesCacheSize = ::Settings::Manager::getSize("max nav mesh tiles cache size", "Navigator");
         result.mEnableWriteRecastMeshToFile
             = ::Settings::Manager::getBool("enable write recast mesh to file", "Navigator");
@@ -192,6 +192,9 @@ namespace ESM
         // format 21 - Random state in saved games.
         REC_RAND = esm3Recname("RAND"), // Random state.
 
+        // format 22 - Compressed blocks of records in saved games.
+        REC_ZBLK = esm3Recname("ZBLK"), // Compressed block of records.
+
         REC_AACT4 = esm4Recname(ESM4::REC_AACT), // Action
         REC_ACHR4 = esm4Recname(ESM4::REC_ACHR), // Actor Reference
         REC_ACTI4 = esm4Recname(ESM4::REC_ACTI), // Activator
@@ -4,6 +4,7 @@
 
 #include <components/files/conversion.hpp>
 #include <components/files/openfile.hpp>
+#include <components/misc/compression.hpp>
 #include <components/misc/strings/algorithm.hpp>
 
 #include <filesystem>
@@ -100,6 +101,31 @@ namespace ESM
         openRaw(Files::openBinaryInputFileStream(filename), filename);
     }
 
+    void ESMReader::openCompressedBlock(ESMReader& parent)
+    {
+        openDecompressedBlock(parent, Misc::decompress(parent.getCompressedBlock()));
+    }
+
+    std::vector<std::byte> ESMReader::getCompressedBlock()
+    {
+        getSubNameIs("DATA");
+        getSubHeader();
+        std::vector<std::byte> data(getSubSize());
+        getExact(data.data(), static_cast<int>(data.size()));
+        return data;
+    }
+
+    void ESMReader::openDecompressedBlock(const ESMReader& parent, const std::vector<std::byte>& records)
+    {
+        openRaw(std::make_unique<std::istringstream>(
+                    std::string(reinterpret_cast<const char*>(records.data()), records.size())),
+            parent.getName());
+        mHeader = parent.mHeader;
+        mEncoder = parent.mEncoder;
+        mCtx.index = parent.mCtx.index;
+        mCtx.parentFileIndices = parent.mCtx.parentFileIndices;
+    }
+
     void ESMReader::open(std::unique_ptr<std::istream>&& stream, const std::filesystem::path& name)
     {
         openRaw(std::move(stream), name);
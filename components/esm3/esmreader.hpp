@@ -1,6 +1,7 @@
 #ifndef OPENMW_ESM_READER_H
 #define OPENMW_ESM_READER_H
 
+#include <cstddef>
 #include <cstdint>
 #include <filesystem>
 #include <istream>
@@ -72,6 +73,17 @@ namespace ESM
 
         void openRaw(const std::filesystem::path& filename);
 
+        /// Open records of the compressed block (REC_ZBLK) which is the current record of \a parent. The records are
+        /// read as if they were a part of the parent file. The parent record is consumed.
+        void openCompressedBlock(ESMReader& parent);
+
+        /// Read the compressed data of the current record which must be a compressed block (REC_ZBLK). The record is
+        /// consumed. Can be used to decompress the data elsewhere and to open it with openDecompressedBlock.
+        std::vector<std::byte> getCompressedBlock();
+
+        /// Open records decompressed from a block of \a parent as if they were a part of the parent file.
+        void openDecompressedBlock(const ESMReader& parent, const std::vector<std::byte>& records);
+
         /// Get the current position in the file. Make sure that the file has been opened!
         size_t getFileOffset() const { return mEsm->tellg(); }
 
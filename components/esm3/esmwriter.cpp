@@ -1,20 +1,22 @@
 #include "esmwriter.hpp"
 
 #include <cassert>
-#include <fstream>
+#include <cstring>
+#include <ostream>
 #include <stdexcept>
 
+#include <components/esm/defs.hpp>
+#include <components/misc/compression.hpp>
 #include <components/to_utf8/to_utf8.hpp>
 
 namespace ESM
 {
     ESMWriter::ESMWriter()
         : mRecords()
+        , mCompressionBlockSize(0)
         , mStream(nullptr)
-        , mHeaderPos()
         , mEncoder(nullptr)
         , mRecordCount(0)
-        , mCounting(true)
         , mHeader()
     {
     }
@@ -71,7 +73,9 @@ namespace ESM
     {
         mRecordCount = 0;
         mRecords.clear();
-        mCounting = true;
+        mBuffer.clear();
+        mBlock.clear();
+        mCompressionBlockSize = 0;
         mStream = &file;
 
         startRecord("TES3", 0);
@@ -85,16 +89,30 @@ namespace ESM
     {
         if (!mRecords.empty())
             throw std::runtime_error("Unclosed record remaining");
+        flush();
+        writeBlock();
+    }
+
+    void ESMWriter::setCompressionBlockSize(std::size_t value)
+    {
+        if (!mRecords.empty())
+            throw std::logic_error("Compression can't be changed inside a record");
+        flush();
+        writeBlock();
+        mCompressionBlockSize = value;
     }
 
     void ESMWriter::startRecord(NAME name, uint32_t flags)
     {
         mRecordCount++;
 
+        if (mRecords.empty())
+            flush();
+
         writeName(name);
         RecordData rec;
         rec.name = name;
-        rec.position = mStream->tellp();
+        rec.position = mBuffer.size();
         rec.size = 0;
         writeT<uint32_t>(0); // Size goes here
         writeT<uint32_t>(0); // Unused header?
@@ -114,10 +132,13 @@ namespace ESM
         // Sub-record hierarchies are not properly supported in ESMReader. This should be fixed later.
         assert(mRecords.size() <= 1);
 
+        if (mRecords.empty())
+            flush();
+
         writeName(name);
         RecordData rec;
         rec.name = name;
-        rec.position = mStream->tellp();
+        rec.position = mBuffer.size();
         rec.size = 0;
         writeT<uint32_t>(0); // Size goes here
         mRecords.push_back(rec);
@@ -131,13 +152,10 @@ namespace ESM
         assert(rec.name == name);
         mRecords.pop_back();
 
-        mStream->seekp(rec.position);
-
-        mCounting = false;
-        write(reinterpret_cast<const char*>(&rec.size), sizeof(uint32_t));
-        mCounting = true;
+        std::memcpy(mBuffer.data() + rec.position, &rec.size, sizeof(uint32_t));
 
-        mStream->seekp(0, std::ios::end);
+        if (mRecords.empty())
+            flush();
     }
 
     void ESMWriter::endRecord(uint32_t name)
@@ -203,13 +221,49 @@ namespace ESM
 
     void ESMWriter::write(const char* data, size_t size)
     {
-        if (mCounting && !mRecords.empty())
+        for (RecordData& record : mRecords)
+            record.size += static_cast<uint32_t>(size);
+
+        mBuffer.insert(mBuffer.end(), data, data + size);
+    }
+
+    void ESMWriter::flush()
+    {
+        if (mBuffer.empty())
+            return;
+        if (mCompressionBlockSize == 0)
         {
-            for (std::list<RecordData>::iterator it = mRecords.begin(); it != mRecords.end(); ++it)
-                it->size += static_cast<uint32_t>(size);
+            mStream->write(mBuffer.data(), static_cast<std::streamsize>(mBuffer.size()));
+            mBuffer.clear();
+            return;
         }
+        const std::byte* const data = reinterpret_cast<const std::byte*>(mBuffer.data());
+        mBlock.insert(mBlock.end(), data, data + mBuffer.size());
+        mBuffer.clear();
+        if (mBlock.size() >= mCompressionBlockSize)
+            writeBlock();
+    }
 
-        mStream->write(data, size);
+    void ESMWriter::writeBlock()
+    {
+        if (mBlock.empty())
+            return;
+
+        const std::vector<std::byte> data = Misc::compress(mBlock);
+        mBlock.clear();
+
+        // Written directly to the stream as there may be no more records to flush it
+        const auto writeRaw = [&](const auto& value) {
+            mStream->write(reinterpret_cast<const char*>(&value), sizeof(value));
+        };
+        const uint32_t subSize = static_cast<uint32_t>(data.size());
+        writeRaw(NAME(REC_ZBLK));
+        writeRaw(static_cast<uint32_t>(NAME::sCapacity + sizeof(uint32_t) + subSize));
+        writeRaw(uint32_t{ 0 }); // Unused header
+        writeRaw(uint32_t{ 0 }); // Flags
+        writeRaw(NAME("DATA"));
+        writeRaw(subSize);
+        mStream->write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
     }
 
     void ESMWriter::setEncoder(ToUTF8::Utf8Encoder* encoder)
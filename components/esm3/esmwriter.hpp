@@ -1,9 +1,11 @@
 #ifndef OPENMW_ESM_WRITER_H
 #define OPENMW_ESM_WRITER_H
 
+#include <cstddef>
 #include <iosfwd>
 #include <list>
 #include <type_traits>
+#include <vector>
 
 #include "components/esm/esmcommon.hpp"
 #include "loadtes3.hpp"
@@ -21,7 +23,7 @@ namespace ESM
         struct RecordData
         {
             NAME name;
-            std::streampos position;
+            std::size_t position;
             uint32_t size;
         };
 
@@ -55,7 +57,12 @@ namespace ESM
         ///< Start saving a file by writing the TES3 header.
 
         void close();
-        ///< \note Does not close the stream.
+        ///< Write buffered data to the stream.
+        /// \note Does not close the stream.
+
+        void setCompressionBlockSize(std::size_t value);
+        ///< Following top level records are grouped into blocks of at least \a value bytes and each block is written
+        /// as a single compressed REC_ZBLK record. Zero disables compression. Records written before are not affected.
 
         void writeHNString(NAME name, const std::string& data);
         void writeHNString(NAME name, const std::string& data, size_t size);
@@ -144,11 +151,17 @@ namespace ESM
 
     private:
         std::list<RecordData> mRecords;
+        // Records are built in memory and written to the stream once complete, so record sizes are patched without
+        // seeking the stream
+        std::vector<char> mBuffer;
+        std::vector<std::byte> mBlock;
+        std::size_t mCompressionBlockSize;
         std::ostream* mStream;
-        std::streampos mHeaderPos;
         ToUTF8::Utf8Encoder* mEncoder;
         int mRecordCount;
-        bool mCounting;
+
+        void flush();
+        void writeBlock();
 
         Header mHeader;
     };
@@ -278,13 +278,9 @@ namespace LuaUtil
 
     void ScriptsContainer::receiveEvent(std::string_view eventName, std::string_view eventData)
     {
-        auto it = mEventHandlers.find(eventName);
-        if (it == mEventHandlers.end())
-        {
-            Log(Debug::Warning) << mNamePrefix << " has received event '" << eventName
-                                << "', but there are no handlers for this event";
+        EventHandlerList* list = findEventHandlers(eventName);
+        if (list == nullptr)
             return;
-        }
         sol::object data;
         try
         {
@@ -295,7 +291,90 @@ namespace LuaUtil
             Log(Debug::Error) << mNamePrefix << " can not parse eventData for '" << eventName << "': " << e.what();
             return;
         }
-        EventHandlerList& list = it->second;
+        callEventHandlers(eventName, *list, data);
+    }
+
+    // Pushes a copy of a value created by `deserialize`. Such values don't have metatables and cycles.
+    // Tables are copied recursively; strings and userdata are shared because they are immutable.
+    static void pushDeserializedCopy(lua_State* L, int index)
+    {
+        if (lua_type(L, index) != LUA_TTABLE)
+        {
+            lua_pushvalue(L, index);
+            return;
+        }
+        if (index < 0)
+            index = lua_gettop(L) + index + 1;
+        luaL_checkstack(L, 5, "Too many nested tables in event data");
+        lua_createtable(L, 0, 0);
+        lua_pushnil(L);
+        while (lua_next(L, index) != 0)
+        {
+            pushDeserializedCopy(L, -2);
+            pushDeserializedCopy(L, -2);
+            lua_rawset(L, -5);
+            lua_pop(L, 1);
+        }
+    }
+
+    void ScriptsContainer::receiveEvent(
+        std::string_view eventName, std::string_view eventData, const std::vector<ScriptsContainer*>& receivers)
+    {
+        if (receivers.size() == 1)
+        {
+            receivers.front()->receiveEvent(eventName, eventData);
+            return;
+        }
+
+        // The data is deserialized once per LuaState and serializer. Every receiver gets its own copy of
+        // the tables, so handlers can't see changes made by handlers of other receivers.
+        lua_State* prototypeLua = nullptr;
+        const UserdataSerializer* prototypeSerializer = nullptr;
+        sol::object prototype;
+        for (ScriptsContainer* receiver : receivers)
+        {
+            EventHandlerList* list = receiver->findEventHandlers(eventName);
+            if (list == nullptr)
+                continue;
+            lua_State* L = receiver->mLua.sol().lua_state();
+            if (prototypeLua != L || prototypeSerializer != receiver->mSerializer)
+            {
+                try
+                {
+                    prototype = LuaUtil::deserialize(L, eventData, receiver->mSerializer);
+                }
+                catch (std::exception& e)
+                {
+                    Log(Debug::Error) << receiver->mNamePrefix << " can not parse eventData for '" << eventName
+                                      << "': " << e.what();
+                    continue;
+                }
+                prototypeLua = L;
+                prototypeSerializer = receiver->mSerializer;
+            }
+            prototype.push(L);
+            pushDeserializedCopy(L, -1);
+            sol::object data = sol::stack::pop<sol::object>(L);
+            lua_pop(L, 1);
+            receiver->callEventHandlers(eventName, *list, data);
+        }
+    }
+
+    ScriptsContainer::EventHandlerList* ScriptsContainer::findEventHandlers(std::string_view eventName)
+    {
+        auto it = mEventHandlers.find(eventName);
+        if (it == mEventHandlers.end())
+        {
+            Log(Debug::Warning) << mNamePrefix << " has received event '" << eventName
+                                << "', but there are no handlers for this event";
+            return nullptr;
+        }
+        return &it->second;
+    }
+
+    void ScriptsContainer::callEventHandlers(
+        std::string_view eventName, EventHandlerList& list, const sol::object& data)
+    {
         for (int i = list.size() - 1; i >= 0; --i)
         {
             try
@@ -113,6 +113,11 @@ namespace LuaUtil
         // (including `nil`) has no effect.
         void receiveEvent(std::string_view eventName, std::string_view eventData);
 
+        // Delivers the same event to several containers. Equivalent to calling `receiveEvent` for each of them,
+        // but the data is deserialized only once per LuaState (receivers get independent copies of tables).
+        static void receiveEvent(
+            std::string_view eventName, std::string_view eventData, const std::vector<ScriptsContainer*>& receivers);
+
         // Serializer defines how to serialize/deserialize userdata. If serializer is not provided,
         // only built-in types and types from util package can be serialized.
         void setSerializer(const UserdataSerializer* serializer) { mSerializer = serializer; }
@@ -226,6 +231,10 @@ namespace LuaUtil
         // Returns script by id (throws an exception if doesn't exist)
         Script& getScript(int scriptId);
 
+        // Returns nullptr (and prints a warning) if there are no handlers for the event.
+        EventHandlerList* findEventHandlers(std::string_view eventName);
+        void callEventHandlers(std::string_view eventName, EventHandlerList& list, const sol::object& data);
+
         void printError(int scriptId, std::string_view msg, const std::exception& e);
         const std::string& scriptPath(int scriptId) const { return mLua.getConfiguration()[scriptId].mScriptPath; }
         void callOnInit(int scriptId, const sol::function& onInit, std::string_view data);
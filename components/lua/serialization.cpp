@@ -1,5 +1,8 @@
 #include "serialization.hpp"
 
+#include <cmath>
+#include <limits>
+
 #include <osg/Matrixf>
 #include <osg/Quat>
 #include <osg/Vec2f>
@@ -15,7 +18,8 @@
 namespace LuaUtil
 {
 
-    constexpr unsigned char FORMAT_VERSION = 0;
+    // Version 1 added INT8 and INT32. Data of version 0 never contains them, so it is read as is.
+    constexpr unsigned char FORMAT_VERSION = 1;
 
     enum class SerializedType : char
     {
@@ -24,6 +28,8 @@ namespace LuaUtil
         BOOLEAN = 0x2,
         TABLE_START = 0x3,
         TABLE_END = 0x4,
+        INT8 = 0x5,
+        INT32 = 0x6,
 
         VEC2 = 0x10,
         VEC3 = 0x11,
@@ -73,6 +79,28 @@ namespace LuaUtil
         out.append(str.data(), str.size());
     }
 
+    static void appendNumber(BinaryData& out, double v)
+    {
+        // Integral numbers are stored in a compact form. It doesn't affect the value after deserialization.
+        const bool isInt32 = v >= std::numeric_limits<int32_t>::min() && v <= std::numeric_limits<int32_t>::max()
+            && std::trunc(v) == v && !(v == 0 && std::signbit(v));
+        if (!isInt32)
+        {
+            appendType(out, SerializedType::NUMBER);
+            appendValue<double>(out, v);
+        }
+        else if (v >= std::numeric_limits<int8_t>::min() && v <= std::numeric_limits<int8_t>::max())
+        {
+            appendType(out, SerializedType::INT8);
+            appendValue<int8_t>(out, static_cast<int8_t>(v));
+        }
+        else
+        {
+            appendType(out, SerializedType::INT32);
+            appendValue<int32_t>(out, static_cast<int32_t>(v));
+        }
+    }
+
     static void appendData(BinaryData& out, const void* data, size_t dataSize)
     {
         out.append(reinterpret_cast<const char*>(data), dataSize);
@@ -219,10 +247,7 @@ namespace LuaUtil
             appendType(out, SerializedType::TABLE_END);
         }
         else if (obj.is<double>())
-        {
-            appendType(out, SerializedType::NUMBER);
-            appendValue<double>(out, obj.as<double>());
-        }
+            appendNumber(out, obj.as<double>());
         else if (obj.is<std::string_view>())
             appendString(out, obj.as<std::string_view>());
         else if (obj.is<bool>())
@@ -274,6 +299,12 @@ namespace LuaUtil
             case SerializedType::NUMBER:
                 sol::stack::push<double>(lua, getValue<double>(binaryData));
                 return;
+            case SerializedType::INT8:
+                sol::stack::push<double>(lua, getValue<int8_t>(binaryData));
+                return;
+            case SerializedType::INT32:
+                sol::stack::push<double>(lua, getValue<int32_t>(binaryData));
+                return;
             case SerializedType::BOOLEAN:
                 sol::stack::push<bool>(lua, getValue<char>(binaryData) != 0);
                 return;
@@ -356,22 +387,71 @@ namespace LuaUtil
         throw std::runtime_error("Unknown type in serialized data: " + std::to_string(type));
     }
 
-    BinaryData serialize(const sol::object& obj, const UserdataSerializer* customSerializer)
+    void serialize(BinaryData& out, const sol::object& obj, const UserdataSerializer* customSerializer)
     {
         if (obj == sol::nil)
-            return "";
+            return;
+        out.push_back(FORMAT_VERSION);
+        serialize(out, obj, customSerializer, 0);
+    }
+
+    BinaryData serialize(const sol::object& obj, const UserdataSerializer* customSerializer)
+    {
         BinaryData res;
-        res.push_back(FORMAT_VERSION);
-        serialize(res, obj, customSerializer, 0);
+        serialize(res, obj, customSerializer);
         return res;
     }
 
+    void SerializedTable::appendFormatVersion(BinaryData& out)
+    {
+        out.push_back(FORMAT_VERSION);
+    }
+
+    void SerializedTable::appendTableStart(BinaryData& out)
+    {
+        appendType(out, SerializedType::TABLE_START);
+    }
+
+    void SerializedTable::appendTableEnd(BinaryData& out)
+    {
+        appendType(out, SerializedType::TABLE_END);
+    }
+
+    void SerializedTable::appendString(BinaryData& out, std::string_view str)
+    {
+        LuaUtil::appendString(out, str);
+    }
+
+    void SerializedTable::appendSerializedValue(BinaryData& out, std::string_view serializedValue)
+    {
+        if (serializedValue.empty() || static_cast<unsigned char>(serializedValue[0]) > FORMAT_VERSION)
+            throw std::runtime_error("Incorrect serialized value");
+        out.append(serializedValue.substr(1));
+    }
+
+    BinaryData BinaryDataPool::acquire()
+    {
+        if (mBuffers.empty())
+            return BinaryData();
+        BinaryData res = std::move(mBuffers.back());
+        mBuffers.pop_back();
+        return res;
+    }
+
+    void BinaryDataPool::release(BinaryData&& data)
+    {
+        if (mBuffers.size() >= mMaxBuffers || data.capacity() > mMaxBufferCapacity)
+            return;
+        data.clear();
+        mBuffers.push_back(std::move(data));
+    }
+
     sol::object deserialize(
         lua_State* lua, std::string_view binaryData, const UserdataSerializer* customSerializer, bool readOnly)
     {
         if (binaryData.empty())
             return sol::nil;
-        if (binaryData[0] != FORMAT_VERSION)
+        if (static_cast<unsigned char>(binaryData[0]) > FORMAT_VERSION)
             throw std::runtime_error("Incorrect version of Lua serialization format: "
                 + std::to_string(static_cast<unsigned>(binaryData[0])));
         binaryData = binaryData.substr(1);
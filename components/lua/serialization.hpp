@@ -51,9 +51,55 @@ namespace LuaUtil
     };
 
     BinaryData serialize(const sol::object&, const UserdataSerializer* customSerializer = nullptr);
+
+    // Appends serialized object to the end of `out`. Unlike the function above it allows to reuse memory
+    // of an existing buffer (see BinaryDataPool).
+    void serialize(BinaryData& out, const sol::object&, const UserdataSerializer* customSerializer = nullptr);
+
+    // Reads directly from `binaryData`; the data is not copied except for strings that are pushed to Lua.
     sol::object deserialize(lua_State* lua, std::string_view binaryData,
         const UserdataSerializer* customSerializer = nullptr, bool readOnly = false);
 
+    // Low-level helpers that compose a serialized table from already serialized values without converting them to
+    // Lua objects. The output is the same as the result of `serialize` for the equivalent table:
+    //     appendFormatVersion(out); appendTableStart(out);
+    //     appendString(out, key); appendSerializedValue(out, serialize(value)); ...
+    //     appendTableEnd(out);
+    // A nested table is added as `appendString(out, key); appendTableStart(out); ... appendTableEnd(out);`.
+    namespace SerializedTable
+    {
+        void appendFormatVersion(BinaryData& out);
+        void appendTableStart(BinaryData& out);
+        void appendTableEnd(BinaryData& out);
+        void appendString(BinaryData& out, std::string_view str);
+        // `serializedValue` is a non-empty result of `serialize`.
+        void appendSerializedValue(BinaryData& out, std::string_view serializedValue);
+    }
+
+    // Keeps released buffers to reuse their memory for new serialized values. Used for short-living data
+    // (like event payloads) to avoid allocations every frame. Not thread safe.
+    class BinaryDataPool
+    {
+    public:
+        explicit BinaryDataPool(std::size_t maxBuffers = 1024, std::size_t maxBufferCapacity = 64 * 1024)
+            : mMaxBuffers(maxBuffers)
+            , mMaxBufferCapacity(maxBufferCapacity)
+        {
+        }
+
+        // Returns an empty buffer, possibly with preallocated memory.
+        BinaryData acquire();
+
+        void release(BinaryData&& data);
+
+        std::size_t size() const { return mBuffers.size(); }
+
+    private:
+        std::size_t mMaxBuffers;
+        std::size_t mMaxBufferCapacity;
+        std::vector<BinaryData> mBuffers;
+    };
+
 }
 
 #endif // COMPONENTS_LUA_SERIALIZATION_H
@@ -75,7 +75,7 @@ namespace LuaUtil
         }
         if (mStorage->mListener)
             mStorage->mListener->valueChanged(mSectionName, key, value);
-        runCallbacks(key);
+        onChanged(key);
     }
 
     void LuaStorage::Section::setAll(const sol::optional<sol::table>& values)
@@ -89,7 +89,52 @@ namespace LuaUtil
         }
         if (mStorage->mListener)
             mStorage->mListener->sectionReplaced(mSectionName, values);
-        runCallbacks(sol::nullopt);
+        onChanged(sol::nullopt);
+    }
+
+    void LuaStorage::Section::onChanged(sol::optional<std::string_view> changedKey)
+    {
+        mSerializedIsValid = false;
+        if (mPermanent)
+            mStorage->mChanged = true;
+        if (!mStorage->mDeferCallbacks)
+        {
+            runCallbacks(changedKey);
+            return;
+        }
+        if (mCallbacks.empty())
+            return;
+        if (changedKey)
+        {
+            if (!mReplaced && mChangedKeys.find(*changedKey) == mChangedKeys.end())
+                mChangedKeys.emplace(*changedKey);
+        }
+        else
+        {
+            mReplaced = true;
+            mChangedKeys.clear();
+        }
+        if (!mHasPendingCallbacks)
+        {
+            mHasPendingCallbacks = true;
+            mStorage->mPendingCallbacks.push_back(mStorage->getSection(mSectionName));
+        }
+    }
+
+    const BinaryData& LuaStorage::Section::getSerialized() const
+    {
+        if (mSerializedIsValid)
+            return mSerialized;
+        mSerialized.clear();
+        SerializedTable::appendTableStart(mSerialized);
+        for (const auto& [key, value] : mValues)
+        {
+            SerializedTable::appendString(mSerialized, key);
+            SerializedTable::appendSerializedValue(mSerialized, value.getSerialized());
+        }
+        SerializedTable::appendTableEnd(mSerialized);
+        mSerializedIsValid = true;
+        return mSerialized;
     }
 
     sol::table LuaStorage::Section::asTable()
@@ -129,6 +174,8 @@ namespace LuaUtil
         sview["removeOnExit"] = [](const SectionView& section) {
             if (section.mReadOnly)
                 throw std::runtime_error("Access to storage is read only");
+            if (section.mSection->mPermanent && !section.mSection->mValues.empty())
+                section.mSection->mStorage->mChanged = true;
             section.mSection->mPermanent = false;
         };
         sview["set"] = [](const SectionView& section, std::string_view key, const sol::object& value) {
@@ -138,8 +185,37 @@ namespace LuaUtil
         };
     }
 
+    void LuaStorage::flushCallbacks()
+    {
+        // Callbacks can change other sections, such changes are delivered on the next call.
+        std::vector<std::shared_ptr<Section>> pending;
+        pending.swap(mPendingCallbacks);
+        for (const std::shared_ptr<Section>& section : pending)
+        {
+            const bool replaced = section->mReplaced;
+            const std::set<std::string, std::less<>> changedKeys = std::move(section->mChangedKeys);
+            section->mChangedKeys.clear();
+            section->mReplaced = false;
+            section->mHasPendingCallbacks = false;
+            if (replaced)
+                section->runCallbacks(sol::nullopt);
+            else
+            {
+                for (const std::string& key : changedKeys)
+                    section->runCallbacks(std::string_view(key));
+            }
+        }
+    }
+
     void LuaStorage::clearTemporaryAndRemoveCallbacks()
     {
+        for (const std::shared_ptr<Section>& section : mPendingCallbacks)
+        {
+            section->mChangedKeys.clear();
+            section->mReplaced = false;
+            section->mHasPendingCallbacks = false;
+        }
+        mPendingCallbacks.clear();
         auto it = mData.begin();
         while (it != mData.end())
         {
@@ -170,6 +246,8 @@ namespace LuaUtil
                 for (const auto& [key, value] : sol::table(sectionTable))
                     section->set(key.as<std::string_view>(), value);
             }
+            mChanged = false;
+            mLastSavedPath = path;
         }
         catch (std::exception& e)
         {
@@ -179,17 +257,30 @@ namespace LuaUtil
 
     void LuaStorage::save(const std::filesystem::path& path) const
     {
-        sol::table data(mLua, sol::create);
+        if (!mChanged && path == mLastSavedPath && std::filesystem::exists(path))
+        {
+            Log(Debug::Verbose) << "Lua storage \"" << path << "\" is not changed";
+            return;
+        }
+        // Values are stored in serialized form, so there is no need to convert them to Lua objects.
+        BinaryData serializedData;
+        SerializedTable::appendFormatVersion(serializedData);
+        SerializedTable::appendTableStart(serializedData);
         for (const auto& [sectionName, section] : mData)
         {
             if (section->mPermanent && !section->mValues.empty())
-                data[sectionName] = section->asTable();
+            {
+                SerializedTable::appendString(serializedData, sectionName);
+                serializedData.append(section->getSerialized());
+            }
         }
-        std::string serializedData = serialize(data);
+        SerializedTable::appendTableEnd(serializedData);
         Log(Debug::Info) << "Saving Lua storage \"" << path << "\" (" << serializedData.size() << " bytes)";
         std::ofstream fout(path, std::fstream::binary);
         fout.write(serializedData.data(), serializedData.size());
         fout.close();
+        mChanged = false;
+        mLastSavedPath = path;
     }
 
     const std::shared_ptr<LuaStorage::Section>& LuaStorage::getSection(std::string_view sectionName)
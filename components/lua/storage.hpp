@@ -1,7 +1,9 @@
 #ifndef COMPONENTS_LUA_STORAGE_H
 #define COMPONENTS_LUA_STORAGE_H
 
+#include <filesystem>
 #include <map>
+#include <set>
 #include <sol/sol.hpp>
 
 #include "scriptscontainer.hpp"
@@ -22,8 +24,17 @@ namespace LuaUtil
 
         void clearTemporaryAndRemoveCallbacks();
         void load(const std::filesystem::path& path);
+
+        // Sections are serialized only if they were changed since the previous `save`. If nothing has changed
+        // since the previous `load` or `save` to the same file, the file is not rewritten.
         void save(const std::filesystem::path& path) const;
 
+        // If enabled, subscription callbacks are not called immediately on change. Instead `flushCallbacks`
+        // (expected to be called once per frame) calls them once per changed key, or once with key `nil`
+        // if the section was reset.
+        void setDeferCallbacks(bool defer) { mDeferCallbacks = defer; }
+        void flushCallbacks();
+
         sol::object getSection(std::string_view sectionName, bool readOnly);
         sol::object getMutableSection(std::string_view sectionName) { return getSection(sectionName, false); }
         sol::object getReadOnlySection(std::string_view sectionName) { return getSection(sectionName, true); }
@@ -59,6 +70,7 @@ namespace LuaUtil
             }
             sol::object getCopy(lua_State* L) const;
             sol::object getReadOnly(lua_State* L) const;
+            const std::string& getSerialized() const { return mSerializedValue; }
 
         private:
             std::string mSerializedValue;
@@ -78,6 +90,8 @@ namespace LuaUtil
             sol::table asTable();
             void runCallbacks(sol::optional<std::string_view> changedKey);
             void throwIfCallbackRecursionIsTooDeep();
+            void onChanged(sol::optional<std::string_view> changedKey);
+            const BinaryData& getSerialized() const;
 
             LuaStorage* mStorage;
             std::string mSectionName;
@@ -85,6 +99,15 @@ namespace LuaUtil
             std::vector<Callback> mCallbacks;
             bool mPermanent = true;
             static Value sEmpty;
+
+            // Used if callbacks are deferred.
+            std::set<std::string, std::less<>> mChangedKeys;
+            bool mReplaced = false;
+            bool mHasPendingCallbacks = false;
+
+            // Serialized content of the section, without format version. Rebuilt on save if the section is changed.
+            mutable BinaryData mSerialized;
+            mutable bool mSerializedIsValid = false;
         };
         struct SectionView
         {
@@ -98,6 +121,13 @@ namespace LuaUtil
         std::map<std::string_view, std::shared_ptr<Section>> mData;
         const Listener* mListener = nullptr;
         std::set<const Section*> mRunningCallbacks;
+
+        bool mDeferCallbacks = false;
+        std::vector<std::shared_ptr<Section>> mPendingCallbacks;
+
+        // Whether the permanent data has changed since the last `load` or `save`.
+        mutable bool mChanged = false;
+        mutable std::filesystem::path mLastSavedPath;
     };
 
 }
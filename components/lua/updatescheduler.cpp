@@ -0,0 +1,76 @@
+#include "updatescheduler.hpp"
+
+#include <algorithm>
+
+#include "scriptscontainer.hpp"
+
+namespace LuaUtil
+{
+    void UpdateScheduler::add(ScriptsContainer* container)
+    {
+        mEntries.emplace(container, Entry{});
+    }
+
+    float UpdateScheduler::getPendingTime(ScriptsContainer* container) const
+    {
+        auto it = mEntries.find(container);
+        if (it == mEntries.end())
+            return 0;
+        return it->second.mPendingDt;
+    }
+
+    void UpdateScheduler::runUpdate(ScriptsContainer& container, Entry& entry)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        container.update(entry.mPendingDt);
+        const Duration cost = std::chrono::steady_clock::now() - start;
+
+        if (entry.mAverageCost == Duration::zero())
+            entry.mAverageCost = cost;
+        else
+            entry.mAverageCost = (entry.mAverageCost * 3 + cost) / 4;
+        entry.mPendingDt = 0;
+        entry.mSkippedFrames = 0;
+        ++mStats.mUpdated;
+    }
+
+    void UpdateScheduler::update(float dt, const GetPriority& getPriority)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        mStats = Stats{};
+        mCandidates.clear();
+
+        const bool unlimited = mSettings.mBudget <= Duration::zero();
+        for (auto& [container, entry] : mEntries)
+        {
+            entry.mPendingDt += dt;
+            if (unlimited || entry.mSkippedFrames >= mSettings.mMaxSkippedFrames)
+            {
+                runUpdate(*container, entry);
+                continue;
+            }
+            const float priority = getPriority(*container);
+            if (priority <= mSettings.mFullRatePriority)
+                runUpdate(*container, entry);
+            else
+                mCandidates.push_back(Candidate{ priority / (1 + entry.mSkippedFrames), container, &entry });
+        }
+
+        std::sort(mCandidates.begin(), mCandidates.end(),
+            [](const Candidate& l, const Candidate& r) { return l.mScore < r.mScore; });
+
+        for (const Candidate& candidate : mCandidates)
+        {
+            const Duration remaining = mSettings.mBudget - (std::chrono::steady_clock::now() - start);
+            if (remaining > candidate.mEntry->mAverageCost)
+                runUpdate(*candidate.mContainer, *candidate.mEntry);
+            else
+            {
+                ++candidate.mEntry->mSkippedFrames;
+                ++mStats.mDeferred;
+            }
+        }
+
+        mStats.mTime = std::chrono::steady_clock::now() - start;
+    }
+}
@@ -0,0 +1,88 @@
+#ifndef COMPONENTS_LUA_UPDATESCHEDULER_H
+#define COMPONENTS_LUA_UPDATESCHEDULER_H
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <vector>
+
+namespace LuaUtil
+{
+    class ScriptsContainer;
+
+    // Calls `onUpdate` for a set of ScriptsContainers, keeping the total time spent in the handlers within
+    // a per-frame budget.
+    //
+    // Every container gets a priority (the lower the value, the more important the container is; usually
+    // it is the distance to the player). Containers with priority not greater than `mFullRatePriority` are
+    // updated every frame regardless of the budget. The rest are updated in the order of priority while
+    // the budget allows. A skipped container accumulates `dt` and receives the sum on the next call of
+    // `onUpdate`, so scripts that integrate over time behave the same way as if they were updated every frame.
+    // A container can't be skipped more than `mMaxSkippedFrames` times in a row.
+    class UpdateScheduler
+    {
+    public:
+        using Duration = std::chrono::steady_clock::duration;
+
+        struct Settings
+        {
+            // Zero means no limit; in this case all containers are updated every frame.
+            Duration mBudget = Duration::zero();
+            float mFullRatePriority = 0;
+            unsigned mMaxSkippedFrames = 0;
+        };
+
+        struct Stats
+        {
+            std::size_t mUpdated = 0;
+            std::size_t mDeferred = 0;
+            Duration mTime = Duration::zero();
+        };
+
+        using GetPriority = std::function<float(const ScriptsContainer&)>;
+
+        void setSettings(const Settings& settings) { mSettings = settings; }
+        const Settings& getSettings() const { return mSettings; }
+
+        // A newly added container starts with zero accumulated time.
+        void add(ScriptsContainer* container);
+        void remove(ScriptsContainer* container) { mEntries.erase(container); }
+        void clear() { mEntries.clear(); }
+
+        bool contains(ScriptsContainer* container) const { return mEntries.count(container) != 0; }
+        std::size_t size() const { return mEntries.size(); }
+
+        // Time that is accumulated by the container since its last update (including the current frame
+        // if the container was deferred).
+        float getPendingTime(ScriptsContainer* container) const;
+
+        void update(float dt, const GetPriority& getPriority);
+
+        const Stats& getStats() const { return mStats; }
+
+    private:
+        struct Entry
+        {
+            float mPendingDt = 0;
+            unsigned mSkippedFrames = 0;
+            // Exponential moving average of the time spent in `onUpdate`.
+            Duration mAverageCost = Duration::zero();
+        };
+
+        struct Candidate
+        {
+            float mScore;
+            ScriptsContainer* mContainer;
+            Entry* mEntry;
+        };
+
+        void runUpdate(ScriptsContainer& container, Entry& entry);
+
+        Settings mSettings;
+        std::map<ScriptsContainer*, Entry> mEntries;
+        std::vector<Candidate> mCandidates;
+        Stats mStats;
+    };
+}
+
+#endif // COMPONENTS_LUA_UPDATESCHEDULER_H
@@ -0,0 +1,239 @@
+#ifndef OPENMW_COMPONENTS_MISC_CHUNKEDVECTOR_H
+#define OPENMW_COMPONENTS_MISC_CHUNKEDVECTOR_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Misc
+{
+    // Sequence of elements stored in a few contiguous chunks. Appending never moves existing elements, so pointers,
+    // references and iterators to them stay valid like for std::list, while iteration goes through contiguous memory.
+    // Chunks grow geometrically up to maxChunkSize elements to not waste memory on short sequences.
+    // Erasing moves following elements and invalidates pointers to them.
+    template <class T, std::size_t maxChunkSize = 256>
+    class ChunkedVector
+    {
+        static constexpr std::size_t sMinChunkSize = 4;
+
+        static_assert(maxChunkSize >= sMinChunkSize);
+
+        using Chunks = std::vector<std::vector<T>>;
+
+    public:
+        template <class Value>
+        class IteratorBase
+        {
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type = std::remove_const_t<Value>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = Value*;
+            using reference = Value&;
+
+            IteratorBase() = default;
+
+            template <class OtherValue, class = std::enable_if_t<std::is_convertible_v<OtherValue*, Value*>>>
+            IteratorBase(const IteratorBase<OtherValue>& other)
+                : mChunks(other.mChunks)
+                , mChunk(other.mChunk)
+                , mOffset(other.mOffset)
+            {
+            }
+
+            reference operator*() const { return (*mChunks)[mChunk][mOffset]; }
+
+            pointer operator->() const { return &**this; }
+
+            IteratorBase& operator++()
+            {
+                ++mOffset;
+                if (mOffset == (*mChunks)[mChunk].size() && mChunk + 1 < mChunks->size())
+                {
+                    ++mChunk;
+                    mOffset = 0;
+                }
+                return *this;
+            }
+
+            IteratorBase operator++(int)
+            {
+                IteratorBase result = *this;
+                ++*this;
+                return result;
+            }
+
+            IteratorBase& operator--()
+            {
+                if (mOffset == 0)
+                {
+                    --mChunk;
+                    mOffset = (*mChunks)[mChunk].size();
+                }
+                --mOffset;
+                return *this;
+            }
+
+            IteratorBase operator--(int)
+            {
+                IteratorBase result = *this;
+                --*this;
+                return result;
+            }
+
+            template <class OtherValue>
+            bool operator==(const IteratorBase<OtherValue>& other) const
+            {
+                return mChunk == other.mChunk && mOffset == other.mOffset && mChunks == other.mChunks;
+            }
+
+            template <class OtherValue>
+            bool operator!=(const IteratorBase<OtherValue>& other) const
+            {
+                return !(*this == other);
+            }
+
+        private:
+            using ChunksPtr = std::conditional_t<std::is_const_v<Value>, const Chunks*, Chunks*>;
+
+            ChunksPtr mChunks = nullptr;
+            std::size_t mChunk = 0;
+            std::size_t mOffset = 0;
+
+            IteratorBase(ChunksPtr chunks, std::size_t chunk, std::size_t offset)
+                : mChunks(chunks)
+                , mChunk(chunk)
+                , mOffset(offset)
+            {
+            }
+
+            template <class>
+            friend class IteratorBase;
+
+            friend class ChunkedVector;
+        };
+
+        using value_type = T;
+        using size_type = std::size_t;
+        using iterator = IteratorBase<T>;
+        using const_iterator = IteratorBase<const T>;
+
+        ChunkedVector() = default;
+
+        ChunkedVector(const ChunkedVector& other)
+        {
+            for (const T& value : other)
+                push_back(value);
+        }
+
+        ChunkedVector(ChunkedVector&& other) noexcept
+            : mChunks(std::move(other.mChunks))
+            , mSize(std::exchange(other.mSize, 0))
+        {
+        }
+
+        ChunkedVector& operator=(const ChunkedVector& other)
+        {
+            ChunkedVector copy(other);
+            swap(copy);
+            return *this;
+        }
+
+        ChunkedVector& operator=(ChunkedVector&& other) noexcept
+        {
+            ChunkedVector moved(std::move(other));
+            swap(moved);
+            return *this;
+        }
+
+        void swap(ChunkedVector& other) noexcept
+        {
+            mChunks.swap(other.mChunks);
+            std::swap(mSize, other.mSize);
+        }
+
+        std::size_t size() const { return mSize; }
+
+        bool empty() const { return mSize == 0; }
+
+        iterator begin() { return iterator(&mChunks, 0, 0); }
+        const_iterator begin() const { return const_iterator(&mChunks, 0, 0); }
+
+        iterator end() { return iterator(&mChunks, getLastChunk(), getLastChunkSize()); }
+        const_iterator end() const { return const_iterator(&mChunks, getLastChunk(), getLastChunkSize()); }
+
+        T& front() { return mChunks.front().front(); }
+        const T& front() const { return mChunks.front().front(); }
+
+        T& back() { return mChunks.back().back(); }
+        const T& back() const { return mChunks.back().back(); }
+
+        void push_back(const T& value) { emplace_back(value); }
+
+        void push_back(T&& value) { emplace_back(std::move(value)); }
+
+        template <class... Args>
+        T& emplace_back(Args&&... args)
+        {
+            if (mChunks.empty() || mChunks.back().size() == mChunks.back().capacity())
+            {
+                // Capacity of the chunk is never exceeded, so its elements never move
+                mChunks.emplace_back().reserve(getNextChunkSize());
+            }
+            T& result = mChunks.back().emplace_back(std::forward<Args>(args)...);
+            ++mSize;
+            return result;
+        }
+
+        void pop_back()
+        {
+            assert(mSize > 0);
+            mChunks.back().pop_back();
+            if (mChunks.back().empty())
+                mChunks.pop_back();
+            --mSize;
+        }
+
+        iterator erase(const_iterator position)
+        {
+            assert(position.mChunks == &mChunks);
+            const iterator result(&mChunks, position.mChunk, position.mOffset);
+            iterator current = result;
+            for (iterator next = std::next(current); next != end(); ++current, ++next)
+                *current = std::move(*next);
+            pop_back();
+            if (result.mChunk < mChunks.size() && result.mOffset < mChunks[result.mChunk].size())
+                return result;
+            return end();
+        }
+
+        void clear()
+        {
+            mChunks.clear();
+            mSize = 0;
+        }
+
+    private:
+        // All chunks but the last one are full and the last one is not empty
+        Chunks mChunks;
+        std::size_t mSize = 0;
+
+        std::size_t getNextChunkSize() const
+        {
+            std::size_t result = sMinChunkSize;
+            for (std::size_t i = 0; i < mChunks.size() && result < maxChunkSize; ++i)
+                result *= 2;
+            return std::min(result, maxChunkSize);
+        }
+
+        std::size_t getLastChunk() const { return mChunks.empty() ? 0 : mChunks.size() - 1; }
+
+        std::size_t getLastChunkSize() const { return mChunks.empty() ? 0 : mChunks.back().size(); }
+    };
+}
+
+#endif
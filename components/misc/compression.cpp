@@ -1,20 +1,31 @@
 #include "compression.hpp"
+#include "endianness.hpp"
 
 #include <lz4.h>
 
 #include <cstddef>
+#include <cstdint>
 #include <cstring>
+#include <limits>
 #include <stdexcept>
 #include <string>
 #include <vector>
 
 namespace Misc
 {
+    namespace
+    {
+        // Size of the original data is stored as little-endian 64-bit value to not depend on the platform
+        using SizePrefix = std::uint64_t;
+    }
+
     std::vector<std::byte> compress(const std::vector<std::byte>& data)
     {
-        const std::size_t originalSize = data.size();
+        if (data.size() > static_cast<std::size_t>(LZ4_MAX_INPUT_SIZE))
+            throw std::runtime_error("Data is too large to compress: " + std::to_string(data.size()));
+        const SizePrefix originalSize = toLittleEndian(static_cast<SizePrefix>(data.size()));
         std::vector<std::byte> result(
-            static_cast<std::size_t>(LZ4_compressBound(static_cast<int>(originalSize)) + sizeof(originalSize)));
+            static_cast<std::size_t>(LZ4_compressBound(static_cast<int>(data.size()))) + sizeof(originalSize));
         const int size = LZ4_compress_default(reinterpret_cast<const char*>(data.data()),
             reinterpret_cast<char*>(result.data()) + sizeof(originalSize), static_cast<int>(data.size()),
             static_cast<int>(result.size() - sizeof(originalSize)));
@@ -27,15 +38,22 @@ namespace Misc
 
     std::vector<std::byte> decompress(const std::vector<std::byte>& data)
     {
-        std::size_t originalSize;
+        SizePrefix originalSize;
+        if (data.size() < sizeof(originalSize))
+            throw std::runtime_error("Compressed data is too short: " + std::to_string(data.size()));
         std::memcpy(&originalSize, data.data(), sizeof(originalSize));
-        std::vector<std::byte> result(originalSize);
+        originalSize = fromLittleEndian(originalSize);
+        if (originalSize > static_cast<SizePrefix>(LZ4_MAX_INPUT_SIZE))
+            throw std::runtime_error("Invalid size of decompressed data: " + std::to_string(originalSize));
+        const std::size_t compressedSize = data.size() - sizeof(originalSize);
+        if (compressedSize > static_cast<std::size_t>(std::numeric_limits<int>::max()))
+            throw std::runtime_error("Compressed data is too large: " + std::to_string(compressedSize));
+        std::vector<std::byte> result(static_cast<std::size_t>(originalSize));
         const int size = LZ4_decompress_safe(reinterpret_cast<const char*>(data.data()) + sizeof(originalSize),
-            reinterpret_cast<char*>(result.data()), static_cast<int>(data.size() - sizeof(originalSize)),
-            static_cast<int>(result.size()));
+            reinterpret_cast<char*>(result.data()), static_cast<int>(compressedSize), static_cast<int>(result.size()));
         if (size < 0)
             throw std::runtime_error("Failed to decompress");
-        if (originalSize != static_cast<std::size_t>(size))
+        if (originalSize != static_cast<SizePrefix>(size))
             throw std::runtime_error("Size of decompressed data (" + std::to_string(size) + ") doesn't match stored ("
                 + std::to_string(originalSize) + ")");
         return result;
@@ -0,0 +1,173 @@
+#ifndef OPENMW_COMPONENTS_MISC_SPATIALGRID_H
+#define OPENMW_COMPONENTS_MISC_SPATIALGRID_H
+
+#include <osg/Vec3f>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace Misc
+{
+    // Uniform grid over the XY plane for neighbourhood queries over a set of points.
+    // Intended to be rebuilt from scratch when the points move: call `clear`, `insert` for every point and then
+    // `build`. Memory is reused between rebuilds. Queries are valid only after `build` and use exact 3D distances.
+    template <class T>
+    class SpatialGrid
+    {
+    public:
+        explicit SpatialGrid(float cellSize)
+            : mCellSize(cellSize)
+        {
+            assert(cellSize > 0);
+        }
+
+        void clear()
+        {
+            mItems.clear();
+            mBuilt = false;
+        }
+
+        void insert(const osg::Vec3f& position, const T& value)
+        {
+            mItems.push_back(Item{ getKey(getCellX(position.x()), getCellY(position.y())), position, value });
+            mBuilt = false;
+        }
+
+        void build()
+        {
+            std::sort(mItems.begin(), mItems.end(), [](const Item& l, const Item& r) { return l.mKey < r.mKey; });
+            mMin = osg::Vec3f(std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+                std::numeric_limits<float>::max());
+            mMax = -mMin;
+            for (const Item& item : mItems)
+            {
+                for (int i = 0; i < 3; ++i)
+                {
+                    mMin[i] = std::min(mMin[i], item.mPosition[i]);
+                    mMax[i] = std::max(mMax[i], item.mPosition[i]);
+                }
+            }
+            mBuilt = true;
+        }
+
+        bool isBuilt() const { return mBuilt; }
+        std::size_t size() const { return mItems.size(); }
+        bool empty() const { return mItems.empty(); }
+
+        // Calls `f(value, position)` for every point within the axis aligned box.
+        template <class F>
+        void forEachInBox(const osg::Vec3f& min, const osg::Vec3f& max, F&& f) const
+        {
+            forEachInCells(min, max, [&](const Item& item) {
+                const osg::Vec3f& p = item.mPosition;
+                if (p.x() >= min.x() && p.x() <= max.x() && p.y() >= min.y() && p.y() <= max.y() && p.z() >= min.z()
+                    && p.z() <= max.z())
+                    f(item.mValue, item.mPosition);
+            });
+        }
+
+        // Calls `f(value, position)` for every point within the sphere.
+        template <class F>
+        void forEachInRadius(const osg::Vec3f& center, float radius, F&& f) const
+        {
+            const osg::Vec3f extent(radius, radius, radius);
+            const float radius2 = radius * radius;
+            forEachInCells(center - extent, center + extent, [&](const Item& item) {
+                if ((item.mPosition - center).length2() <= radius2)
+                    f(item.mValue, item.mPosition);
+            });
+        }
+
+        // Appends up to `count` nearest points within `maxDistance` to `out` as (distance, value) pairs sorted by
+        // distance.
+        void findNearest(const osg::Vec3f& center, std::size_t count, float maxDistance,
+            std::vector<std::pair<float, T>>& out) const
+        {
+            if (count == 0 || mItems.empty())
+                return;
+            const std::size_t begin = out.size();
+            const float maxUsefulRadius = getMaxUsefulRadius(center);
+            // Grow the search radius until there are enough candidates. All points within the radius are found,
+            // so the nearest `count` among them are the nearest overall.
+            float radius = std::min(mCellSize, maxDistance);
+            while (true)
+            {
+                out.resize(begin);
+                forEachInRadius(center, radius, [&](const T& value, const osg::Vec3f& position) {
+                    out.emplace_back((position - center).length(), value);
+                });
+                if (out.size() - begin >= count || radius >= maxDistance || radius >= maxUsefulRadius)
+                    break;
+                radius = std::min(radius * 2, maxDistance);
+            }
+            const auto first = out.begin() + begin;
+            const auto last = first + std::min(count, out.size() - begin);
+            const auto less = [](const std::pair<float, T>& l, const std::pair<float, T>& r) {
+                return l.first < r.first;
+            };
+            std::partial_sort(first, last, out.end(), less);
+            out.erase(last, out.end());
+        }
+
+    private:
+        struct Item
+        {
+            std::int64_t mKey;
+            osg::Vec3f mPosition;
+            T mValue;
+        };
+
+        float mCellSize;
+        bool mBuilt = false;
+        std::vector<Item> mItems;
+        osg::Vec3f mMin;
+        osg::Vec3f mMax;
+
+        int getCellX(float x) const { return static_cast<int>(std::floor(x / mCellSize)); }
+        int getCellY(float y) const { return static_cast<int>(std::floor(y / mCellSize)); }
+
+        // Items are sorted by the key, so all cells with the same x and consecutive y form a contiguous range.
+        static std::int64_t getKey(int x, int y)
+        {
+            return static_cast<std::int64_t>(x) * (std::int64_t(1) << 32) + static_cast<std::int64_t>(y)
+                - static_cast<std::int64_t>(std::numeric_limits<int>::min());
+        }
+
+        template <class F>
+        void forEachInCells(const osg::Vec3f& min, const osg::Vec3f& max, F&& f) const
+        {
+            assert(mBuilt);
+            if (mItems.empty())
+                return;
+            // Don't iterate over cells outside of the bounds of the items.
+            const int minX = getCellX(std::max(min.x(), mMin.x()));
+            const int maxX = getCellX(std::min(max.x(), mMax.x()));
+            const int minY = getCellY(std::max(min.y(), mMin.y()));
+            const int maxY = getCellY(std::min(max.y(), mMax.y()));
+            const auto keyLess = [](const Item& item, std::int64_t key) { return item.mKey < key; };
+            for (int x = minX; x <= maxX; ++x)
+            {
+                auto it = std::lower_bound(mItems.begin(), mItems.end(), getKey(x, minY), keyLess);
+                const std::int64_t lastKey = getKey(x, maxY);
+                for (; it != mItems.end() && it->mKey <= lastKey; ++it)
+                    f(*it);
+            }
+        }
+
+        // The distance from `center` that covers all items.
+        float getMaxUsefulRadius(const osg::Vec3f& center) const
+        {
+            osg::Vec3f farthest;
+            for (int i = 0; i < 3; ++i)
+                farthest[i] = std::max(std::abs(center[i] - mMin[i]), std::abs(center[i] - mMax[i]));
+            return farthest.length();
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef OPENMW_COMPONENTS_MISC_SPSCQUEUE_H
+#define OPENMW_COMPONENTS_MISC_SPSCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace Misc
+{
+    // Fixed capacity FIFO queue for exactly one producer thread and one consumer thread. Neither side ever waits
+    // for the other one: push fails when the queue is full and pop fails when it is empty.
+    template <class T>
+    class SpscQueue
+    {
+    public:
+        explicit SpscQueue(std::size_t capacity)
+            : mSlots(capacity + 1)
+        {
+        }
+
+        SpscQueue(const SpscQueue&) = delete;
+        SpscQueue& operator=(const SpscQueue&) = delete;
+
+        std::size_t capacity() const { return mSlots.size() - 1; }
+
+        // May be called only by the producer
+        bool push(T&& value)
+        {
+            const std::size_t tail = mTail.load(std::memory_order_relaxed);
+            const std::size_t next = getNext(tail);
+            if (next == mHead.load(std::memory_order_acquire))
+                return false;
+            mSlots[tail] = std::move(value);
+            mTail.store(next, std::memory_order_release);
+            return true;
+        }
+
+        // May be called only by the consumer
+        std::optional<T> pop()
+        {
+            const std::size_t head = mHead.load(std::memory_order_relaxed);
+            if (head == mTail.load(std::memory_order_acquire))
+                return std::nullopt;
+            std::optional<T> result(std::move(mSlots[head]));
+            mSlots[head] = T();
+            mHead.store(getNext(head), std::memory_order_release);
+            return result;
+        }
+
+        // Exact only when called by the producer or the consumer while the other side is inactive
+        std::size_t size() const
+        {
+            const std::size_t head = mHead.load(std::memory_order_acquire);
+            const std::size_t tail = mTail.load(std::memory_order_acquire);
+            return tail >= head ? tail - head : mSlots.size() - head + tail;
+        }
+
+        bool empty() const { return size() == 0; }
+
+        bool full() const { return size() == capacity(); }
+
+    private:
+        // One slot is always left empty to distinguish a full queue from an empty one
+        std::vector<T> mSlots;
+        std::atomic<std::size_t> mHead{ 0 };
+        std::atomic<std::size_t> mTail{ 0 };
+
+        std::size_t getNext(std::size_t index) const { return index + 1 == mSlots.size() ? 0 : index + 1; }
+    };
+}
+
+#endif
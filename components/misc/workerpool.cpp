@@ -0,0 +1,97 @@
+#include "workerpool.hpp"
+
+#include <utility>
+
+namespace Misc
+{
+    WorkerPool::WorkerPool(unsigned threadsCount)
+    {
+        mThreads.reserve(threadsCount);
+        for (unsigned i = 0; i < threadsCount; ++i)
+            mThreads.emplace_back([this] { run(); });
+    }
+
+    WorkerPool::~WorkerPool()
+    {
+        {
+            const std::lock_guard lock(mMutex);
+            mStop = true;
+        }
+        mHasJob.notify_all();
+        for (std::thread& thread : mThreads)
+            thread.join();
+    }
+
+    void WorkerPool::forEach(std::size_t count, const std::function<void(std::size_t)>& f)
+    {
+        if (mThreads.empty() || count <= 1)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                f(i);
+            return;
+        }
+
+        {
+            const std::lock_guard lock(mMutex);
+            mJob = &f;
+            mCount = count;
+            mNext = 0;
+            mException = nullptr;
+            mPending = mThreads.size();
+            ++mGeneration;
+        }
+        mHasJob.notify_all();
+
+        process();
+
+        std::exception_ptr exception;
+        {
+            // Every worker has to finish with the job before `f` goes out of scope
+            std::unique_lock lock(mMutex);
+            mJobDone.wait(lock, [&] { return mPending == 0; });
+            mJob = nullptr;
+            exception = std::exchange(mException, nullptr);
+        }
+        if (exception)
+            std::rethrow_exception(exception);
+    }
+
+    void WorkerPool::run() noexcept
+    {
+        std::size_t generation = 0;
+        std::unique_lock lock(mMutex);
+        while (true)
+        {
+            mHasJob.wait(lock, [&] { return mStop || mGeneration != generation; });
+            if (mStop)
+                return;
+            generation = mGeneration;
+            lock.unlock();
+            process();
+            lock.lock();
+            if (--mPending == 0)
+                mJobDone.notify_one();
+        }
+    }
+
+    void WorkerPool::process()
+    {
+        while (true)
+        {
+            const std::size_t i = mNext.fetch_add(1);
+            if (i >= mCount)
+                return;
+            try
+            {
+                (*mJob)(i);
+            }
+            catch (...)
+            {
+                const std::lock_guard lock(mMutex);
+                if (mException == nullptr)
+                    mException = std::current_exception();
+                mNext = mCount;
+            }
+        }
+    }
+}
@@ -0,0 +1,53 @@
+#ifndef OPENMW_COMPONENTS_MISC_WORKERPOOL_H
+#define OPENMW_COMPONENTS_MISC_WORKERPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Misc
+{
+    // Fixed set of threads to split a loop over independent items between several cores. The calling thread
+    // takes part in the work too, so a pool with 0 threads just runs the loop on the calling thread.
+    class WorkerPool
+    {
+    public:
+        explicit WorkerPool(unsigned threadsCount);
+
+        ~WorkerPool();
+
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+        std::size_t getThreadsCount() const { return mThreads.size(); }
+
+        // Calls `f(i)` for every `i` in [0, count) and returns when all calls are finished. Calls for different
+        // `i` can be done concurrently and in any order. The first exception thrown by `f` stops the loop and
+        // is rethrown by `forEach`. Not reentrant.
+        void forEach(std::size_t count, const std::function<void(std::size_t)>& f);
+
+    private:
+        std::mutex mMutex;
+        std::condition_variable mHasJob;
+        std::condition_variable mJobDone;
+        const std::function<void(std::size_t)>* mJob = nullptr;
+        std::size_t mCount = 0;
+        std::atomic<std::size_t> mNext{ 0 };
+        std::size_t mGeneration = 0;
+        std::size_t mPending = 0;
+        bool mStop = false;
+        std::exception_ptr mException;
+        std::vector<std::thread> mThreads;
+
+        void run() noexcept;
+
+        void process();
+    };
+}
+
+#endif
@@ -1,8 +1,11 @@
 #include "bulletshape.hpp"
 
+#include <cassert>
+#include <new>
 #include <stdexcept>
 #include <string>
 
+#include <BulletCollision/BroadphaseCollision/btDbvt.h>
 #include <BulletCollision/CollisionShapes/btBoxShape.h>
 #include <BulletCollision/CollisionShapes/btCompoundShape.h>
 #include <BulletCollision/CollisionShapes/btHeightfieldTerrainShape.h>
@@ -12,6 +15,42 @@ namespace Resource
 {
     namespace
     {
+        // Compound shape that takes a copy of the children AABB tree from another compound shape instead of building
+        // it from scratch inserting children one by one
+        class CompoundShape : public btCompoundShape
+        {
+        public:
+            explicit CompoundShape(int initialChildCapacity)
+                : btCompoundShape(false, initialChildCapacity)
+            {
+            }
+
+            // Children must be the same and in the same order as in the source
+            void copyAabbTree(const btDbvt& source)
+            {
+                assert(m_dynamicAabbTree == nullptr);
+                void* memory = btAlignedAlloc(sizeof(btDbvt), 16);
+                m_dynamicAabbTree = new (memory) btDbvt();
+                SetChildNode setChildNode(getChildList());
+                source.clone(*m_dynamicAabbTree, &setChildNode);
+                // btDbvt::clone doesn't count leaves
+                m_dynamicAabbTree->m_leaves = source.m_leaves;
+            }
+
+        private:
+            struct SetChildNode : btDbvt::IClone
+            {
+                btCompoundShapeChild* mChildren;
+
+                explicit SetChildNode(btCompoundShapeChild* children)
+                    : mChildren(children)
+                {
+                }
+
+                void CloneLeaf(btDbvtNode* leaf) override { mChildren[leaf->dataAsInt].m_node = leaf; }
+            };
+        };
+
         CollisionShapePtr duplicateCollisionShape(const btCollisionShape* shape)
         {
             if (shape == nullptr)
@@ -20,15 +59,20 @@ namespace Resource
             if (shape->isCompound())
             {
                 const btCompoundShape* comp = static_cast<const btCompoundShape*>(shape);
-                std::unique_ptr<btCompoundShape, DeleteCollisionShape> newShape(new btCompoundShape);
+                const int numChildren = comp->getNumChildShapes();
+                std::unique_ptr<CompoundShape, DeleteCollisionShape> newShape(new CompoundShape(numChildren));
 
-                for (int i = 0, n = comp->getNumChildShapes(); i < n; ++i)
+                for (int i = 0; i < numChildren; ++i)
                 {
                     auto child = duplicateCollisionShape(comp->getChildShape(i));
                     const btTransform& trans = comp->getChildTransform(i);
                     newShape->addChildShape(trans, child.release());
                 }
 
+                // Duplicated children have the same bounds, so the tree built for the source is valid for the copy
+                if (const btDbvt* tree = comp->getDynamicAabbTree())
+                    newShape->copyAabbTree(*tree);
+
                 return newShape;
             }
 
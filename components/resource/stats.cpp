@@ -458,11 +458,19 @@ namespace Resource
                 "Mechanics Objects",
                 "",
                 "Physics Actors",
+                "Physics Actors Sleeping",
                 "Physics Objects",
                 "Physics Projectiles",
                 "Physics HeightFields",
                 "",
+                "Preload Cells",
+                "Preload Hits",
+                "Preload Misses",
+                "Preload Wasted",
+                "",
                 "Lua UsedMemory",
+                "Lua Updated",
+                "Lua Deferred",
             });
 
             static const auto longest = std::max_element(statNames.begin(), statNames.end(),
@@ -26,6 +26,46 @@
 -- Everything that can be picked up in the nearby.
 -- @field [parent=#nearby] openmw.core#ObjectList items
 
+---
+-- @type OBJECT_GROUP
+-- @field [parent=#OBJECT_GROUP] #number Activators Objects from @{#nearby.activators}
+-- @field [parent=#OBJECT_GROUP] #number Actors Objects from @{#nearby.actors}
+-- @field [parent=#OBJECT_GROUP] #number Containers Objects from @{#nearby.containers}
+-- @field [parent=#OBJECT_GROUP] #number Doors Objects from @{#nearby.doors}
+-- @field [parent=#OBJECT_GROUP] #number Items Objects from @{#nearby.items}
+
+---
+-- Groups of nearby objects that are used in spatial queries (`findInRadius`, `findInBox`, `findNearest`).
+-- @field [parent=#nearby] #OBJECT_GROUP OBJECT_GROUP
+
+---
+-- Find objects of the given group within the given distance from a point.
+-- Much faster than iterating over the whole list in Lua.
+-- @function [parent=#nearby] findInRadius
+-- @param #number group One of @{#OBJECT_GROUP}
+-- @param openmw.util#Vector3 center
+-- @param #number radius
+-- @return openmw.core#ObjectList Objects sorted by distance to `center`
+-- @usage local enemies = nearby.findInRadius(nearby.OBJECT_GROUP.Actors, self.position, 1000)
+
+---
+-- Find objects of the given group within an axis-aligned box.
+-- @function [parent=#nearby] findInBox
+-- @param #number group One of @{#OBJECT_GROUP}
+-- @param openmw.util#Vector3 min Minimal corner of the box
+-- @param openmw.util#Vector3 max Maximal corner of the box
+-- @return openmw.core#ObjectList
+
+---
+-- Find the nearest objects of the given group.
+-- @function [parent=#nearby] findNearest
+-- @param #number group One of @{#OBJECT_GROUP}
+-- @param openmw.util#Vector3 center
+-- @param #number count Maximal number of objects to return
+-- @param #number maxDistance (optional) Ignore objects that are farther from `center`
+-- @return openmw.core#ObjectList Objects sorted by distance to `center`
+-- @usage local closestDoor = nearby.findNearest(nearby.OBJECT_GROUP.Doors, self.position, 1)[1]
+
 ---
 -- @type COLLISION_TYPE
 -- @field [parent=#COLLISION_TYPE] #number World
@@ -71,6 +111,18 @@
 --     radius = 10,
 -- })
 
+---
+-- Cast several rays at once. Faster than calling `castRay` for each of them.
+-- @function [parent=#nearby] castRays
+-- @param #list<#table> rays A list of tables with fields `from` and `to` (openmw.util#Vector3).
+-- @param #table options An optional table with additional optional arguments, the same as in `castRay`. Applied to all rays.
+-- @return #list<#RayCastingResult> Results in the same order as the rays.
+-- @usage local results = nearby.castRays({
+--     {from = self.position, to = pointA},
+--     {from = self.position, to = pointB},
+-- }, {ignore = self})
+-- for i, res in ipairs(results) do print(i, res.hit) end
+
 ---
 -- Cast ray from one point to another and find the first visual intersection with anything in the scene.
 -- As opposite to `castRay` can find an intersection with an object without collisions.
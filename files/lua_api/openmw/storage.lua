@@ -61,6 +61,7 @@
 -- Subscribe to changes in this section.
 -- First argument of the callback is the name of the section (so one callback can be used for different sections).
 -- The second argument is the changed key (or `nil` if `reset` was used and all values were changed at the same time)
+-- Callbacks are called once per frame: if a value was changed several times during a frame, the callback is called only once for it.
 -- @function [parent=#StorageSection] subscribe
 -- @param self
 -- @param openmw.async#Callback callback